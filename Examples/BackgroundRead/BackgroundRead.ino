@@ -14,10 +14,13 @@
 **                                                                                                                **
 ** The INA226 is set up to measure using the maximum conversion length (and maximum accuracy) and then average    **
 ** those readings 64 times. This results in readings taking 8.244ms x 64 = 527.616ms or just less than 2 times    **
-** a second. The pin-change interrupt handler is called when a reading is finished and the INA226 pulls the pin   **
-** down to ground, it resets the pin status and adds the readings to the global variables. The main program will  **
-** do whatever processing it has to and every 5 seconds it will display the current averaged readings and reset   **
-** them.                                                                                                          **
+** a second. The library sets up the pin-change interrupt and its handler only sets a flag when a reading is      **
+** finished and the INA226 pulls the pin down to ground, so no I2C traffic takes place inside the interrupt. The  **
+** main program does whatever processing it has to, calls conversionReady() which returns immediately when there  **
+** is nothing new, adds the readings to the global variables and every 10 readings it will display the current    **
+** averaged readings and reset them. Each reading is also added to an INA226_Energy accumulator, which keeps      **
+** the total energy used since the program started using the conversion time of the INA226 instead of the         **
+** Arduino clock.                                                                                                 **
 **                                                                                                                **
 ** The datasheet for the INA226 can be found at http://www.ti.com/lit/ds/symlink/ina226.pdf and it contains the   **
 ** information required in order to hook up the device. Unfortunately it comes as a VSSOP package but it can be   **
@@ -27,7 +30,9 @@
 ** accurate than the INA219.                                                                                      **
 **                                                                                                                **
 ** The interrupt is set to pin 8. The tests were done on an Arduino Micro, and the Atmel 82U4 chip only allows    **
-** pin change interrupt on selected pins (SS,SCK,MISO,MOSI,8) so pin 8 was chosen.                                **
+** pin change interrupt on selected pins (SS,SCK,MISO,MOSI,8) so pin 8 was chosen. Since the pin-change vector    **
+** can be shared with other libraries the sketch forwards it to INA226_Class::alertHandler(); on pins that have   **
+** an external interrupt the library uses attachInterrupt() and no ISR is needed in the sketch.                   **
 **                                                                                                                **
 ** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
 ** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
@@ -38,6 +43,8 @@
 **                                                                                                                **
 ** Vers.  Date       Developer                     Comments                                                       **
 ** ====== ========== ============================= ============================================================== **
+** 1.0.6   2026-10-14 https://github.com/SV-Zanshin Added energy total using INA226_Energy                        **
+** 1.0.5   2026-10-14 https://github.com/SV-Zanshin Library owns interrupt setup, read using conversionReady()    **
 ** 1.0.4   2018-05-29 https://github.com/SV-Zanshin Added checking if the device is actually detected to code     **
 ** 1.0.3   2017-09-29 https://github.com/SV-Zanshin https://github.com/SV-Zanshin/INA226/issues/8. Default values **
 ** 1.0.2   2017-08-10 https://github.com/SV-Zanshin Further changes to comments                                   **
@@ -46,6 +53,7 @@
 **                                                                                                                **
 *******************************************************************************************************************/
 #include <INA226.h>                                                           // INA226 Library                   //
+#include <INA226_Energy.h>                                                    // INA226 energy accumulator        //
 /*******************************************************************************************************************
 ** Declare program Constants                                                                                      **
 *******************************************************************************************************************/
@@ -56,25 +64,16 @@ const uint32_t SERIAL_SPEED       = 115200;                                   //
 ** Declare global variables and instantiate classes                                                               **
 *******************************************************************************************************************/
 INA226_Class INA226;                                                          // INA class instantiation          //
-volatile uint64_t sumBusMillVolts =      0;                                   // Sum of bus voltage readings      //
-volatile int64_t  sumBusMicroAmps =      0;                                   // Sum of bus amperage readings     //
-volatile uint8_t  readings        =      0;                                   // Number of measurements taken     //
+INA226_Energy energy(INA226);                                                 // Energy used by the load          //
+uint64_t          sumBusMillVolts =      0;                                   // Sum of bus voltage readings      //
+int64_t           sumBusMicroAmps =      0;                                   // Sum of bus amperage readings     //
+uint8_t           readings        =      0;                                   // Number of measurements taken     //
 /*******************************************************************************************************************
-** Declare interrupt service routine for the pin-change interrupt on pin 8 which is set in the setup() method     **
+** Forward the pin-change interrupt for pin 8, which the library enables in setAlertInterrupt(), to the library's **
+** handler. This is not needed when the alert pin is connected to an external interrupt pin                       **
 *******************************************************************************************************************/
 ISR (PCINT0_vect) {                                                           // handle pin change interrupt D8   //
-  digitalWrite(GREEN_LED_PIN,!digitalRead(GREEN_LED_PIN));                    // Toggle LED to show we are working//
-  *digitalPinToPCMSK(INA226_ALERT_PIN)&=~bit(digitalPinToPCMSKbit(INA226_ALERT_PIN)); // Disable PCMSK pin        //
-  PCICR  &= ~bit(digitalPinToPCICRbit(INA226_ALERT_PIN));                     // disable interrupt for the group  //
-  sei();                                                                      // Enable interrupts for I2C calls  //
-  sumBusMillVolts += INA226.getBusMilliVolts();                               // Read the current value           //
-  sumBusMicroAmps += INA226.getBusMicroAmps();                                // Read the current value           //
-  readings++;                                                                 // Increment the number of readings //
-  INA226.waitForConversion();                                                 // Resets INA226 interrupt flag     //
-  cli();                                                                      // Disable interrupts               //
-  *digitalPinToPCMSK(INA226_ALERT_PIN)|=bit(digitalPinToPCMSKbit(INA226_ALERT_PIN)); // Enable PCMSK pin          //
-  PCIFR  |= bit (digitalPinToPCICRbit(INA226_ALERT_PIN));                     // clear any outstanding interrupt  //
-  PCICR  |= bit (digitalPinToPCICRbit(INA226_ALERT_PIN));                     // enable interrupt for the group   //
+  INA226_Class::alertHandler();                                               // Let the library set its flag     //
 } // of ISR handler for INT0 group of pins                                    //                                  //
 /*******************************************************************************************************************
 ** Method Setup(). This is an Arduino IDE method which is called first upon initial boot or restart. It is only   **
@@ -84,15 +83,11 @@ ISR (PCINT0_vect) {                                                           //
 void setup() {                                                                //                                  //
   pinMode(GREEN_LED_PIN, OUTPUT);                                             // Define the green LED as an output//
   digitalWrite(GREEN_LED_PIN,true);                                           // Turn on the LED                  //
-  pinMode(INA226_ALERT_PIN,INPUT_PULLUP);                                     // Declare pin with pullup resistors//
-  *digitalPinToPCMSK(INA226_ALERT_PIN)|=bit(digitalPinToPCMSKbit(INA226_ALERT_PIN)); // Enable PCMSK pin          //
-  PCIFR  |= bit (digitalPinToPCICRbit(INA226_ALERT_PIN));                     // clear any outstanding interrupt  //
-  PCICR  |= bit (digitalPinToPCICRbit(INA226_ALERT_PIN));                     // enable interrupt for the group   //
   Serial.begin(SERIAL_SPEED);                                                 // Start serial communications      //
   #ifdef  __AVR_ATmega32U4__                                                  // If this is a 32U4 processor,     //
     delay(3000);                                                              // wait 3 seconds for serial port   //
   #endif                                                                      // interface to initialize          //
-  Serial.print(F("\n\nBackground INA226 Read V1.0.0\n"));                     // Display program information      //
+  Serial.print(F("\n\nBackground INA226 Read V1.0.6\n"));                     // Display program information      //
   // The begin initialized the calibration for an expected ±1 Amps maximum current and for a 0.1Ω resistor        //
   while (INA226.begin(1,100000)==0) {                                         //                                  //
     Serial.print(F("No Device detected. Sleeping 10 seconds.\n"));            //                                  //
@@ -103,6 +98,7 @@ void setup() {                                                                //
   INA226.setShuntConversion(7);                                               // Maximum conversion time 8.244ms  //
   INA226.setMode(INA_MODE_CONTINUOUS_BOTH);                                   // Bus/shunt measured continuously  //
   INA226.setAlertPinOnConversion(true);                                       // Make alert pin go low on finish  //
+  INA226.setAlertInterrupt(INA226_ALERT_PIN);                                 // Library sets up pin interrupt    //
 } // of method setup()                                                        //                                  //
 /*******************************************************************************************************************
 ** This is the main program for the Arduino IDE, it is called in an infinite loop. The INA226 measurements are    **
@@ -111,9 +107,23 @@ void setup() {                                                                //
 void loop() {                                                                 // Main program loop                //
   static long lastMillis = millis();                                          // Store the last time we printed   //
   /*****************************************************************************************************************
+  ** conversionReady() returns immediately without any I2C traffic unless the alert pin has fired, in which case  **
+  ** the new readings are added to the totals                                                                     **
+  *****************************************************************************************************************/
+  if (INA226.conversionReady()) {                                             // If a new reading is available    //
+    digitalWrite(GREEN_LED_PIN,!digitalRead(GREEN_LED_PIN));                  // Toggle LED to show we are working//
+    inaRawSample sample;                                                      // Unconverted register values      //
+    inaReadings  values;                                                      // Converted readings               //
+    INA226.getRawSample(sample);                                              // Read all registers at once       //
+    INA226.convertSample(sample,values);                                      // Convert them to readings         //
+    energy.add(sample);                                                       // Add to the energy total          //
+    sumBusMillVolts += values.busMilliVolts;                                  // Add to the totals                //
+    sumBusMicroAmps += values.busMicroAmps;                                   //                                  //
+    readings++;                                                               // Increment the number of readings //
+  } // of if-then a new reading is available                                  //                                  //
+  /*****************************************************************************************************************
   ** Check to see if we have collected 10 or more readings each main loop iteration, and display the time and     **
-  ** average information before resetting the values. Interrupts are turned off when resetting the values to      **
-  ** ensure atomic operations                                                                                     **
+  ** average information before resetting the values                                                              **
   *****************************************************************************************************************/
   if (readings>=10) {                                                         // If it is time to display results //
     Serial.print(F("Averaging readings taken over "));                        //                                  //
@@ -122,12 +132,12 @@ void loop() {                                                                 //
     Serial.print((float)sumBusMillVolts/readings/1000.0,4);                   //                                  //
     Serial.print(F("V\nBus amperage:  "));                                    //                                  //
     Serial.print((float)sumBusMicroAmps/readings/1000.0,4);                   //                                  //
-    Serial.print(F("mA\n\n"));                                                //                                  //
+    Serial.print(F("mA\nEnergy used:   "));                                   //                                  //
+    Serial.print((float)energy.getMicroWattHours()/1000.0,4);                 //                                  //
+    Serial.print(F("mWh\n\n"));                                               //                                  //
     lastMillis = millis();                                                    //                                  //
-    cli();                                                                    // Disable interrupts               //
     readings        = 0;                                                      // Reset values                     //
     sumBusMillVolts = 0;                                                      // Reset values                     //
     sumBusMicroAmps = 0;                                                      // Reset values                     //
-    sei();                                                                    // Enable interrupts                //
   } // of if-then we've reached the required amount of readings               //                                  //
 } // of method loop                                                           //----------------------------------//
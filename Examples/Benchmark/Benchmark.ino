@@ -0,0 +1,148 @@
+/*******************************************************************************************************************
+** Program to measure how long each public method of the INA226 library takes and how many I2C transactions and   **
+** bytes it causes, at the standard, fast and fast mode plus bus clocks. The numbers are used to check the effect **
+** of changes to the library and to choose the hardware and bus speed for an application.                         **
+**                                                                                                                **
+** Detailed documentation can be found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki      **
+**                                                                                                                **
+** Each method is called REPEATS times in a row and the averages per call are shown. The time is measured with    **
+** micros(), so it includes the processing on the Arduino as well as the time on the bus. The transactions and    **
+** bytes are counted by an INA226_CountingTransport placed between the library and the bus. The first call of     **
+** begin() finds and resets the devices and is timed on its own, later calls only set the calibration. The        **
+** devices use single 140us conversions so that the methods which wait for a conversion show the least time       **
+** possible, and a setting that is written is always the same as the existing one so the devices keep converting. **
+**                                                                                                                **
+** Defining SIMULATE_INA226 runs the program against INA226_SimTransport devices instead, which works on a board  **
+** without any INA226 connected and shows the bus traffic, although the bus clock then makes no difference.       **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+** Vers.  Date       Developer                     Comments                                                       **
+** ====== ========== ============================= ============================================================== **
+** 1.0.1  2026-10-14 https://github.com/SV-Zanshin Added raw getters, startRawSample(), setTrim() and alerts      **
+** 1.0.0  2026-10-14 https://github.com/SV-Zanshin Created example                                                **
+**                                                                                                                **
+*******************************************************************************************************************/
+// #define SIMULATE_INA226                                                    // Uncomment for simulated devices  //
+#include <INA226.h>                                                           // INA226 Library                   //
+#include <INA226_Sim.h>                                                       // Simulated INA226 devices         //
+/*******************************************************************************************************************
+** Declare program Constants                                                                                      **
+*******************************************************************************************************************/
+const uint32_t SERIAL_SPEED       = 115200;                                   // Use fast serial speed            //
+const uint16_t REPEATS            =    100;                                   // Calls averaged for each method   //
+const uint32_t BUS_SPEEDS[3]      = {INA_I2C_STANDARD_MODE,INA_I2C_FAST_MODE, // I2C clocks measured              //
+                                     INA_I2C_FAST_MODE_PLUS};                 //                                  //
+/*******************************************************************************************************************
+** Declare global variables and instantiate classes                                                               **
+*******************************************************************************************************************/
+#ifdef SIMULATE_INA226                                                        // Either simulated devices or the  //
+  INA226_SimTransport  bus;                                                   // real ones on the "Wire" bus      //
+#else                                                                         //                                  //
+  INA226_WireTransport bus;                                                   //                                  //
+#endif                                                                        //                                  //
+INA226_CountingTransport counter(bus);                                        // Counts the bus traffic           //
+INA226_Class             INA226;                                              // INA class instantiation          //
+uint8_t                  devicesFound = 0;                                    // Number of INA226s found          //
+inaReadings              readings;                                            // Readings and samples filled by   //
+inaRawSample             sample;                                              // the methods measured             //
+/*******************************************************************************************************************
+** Method printHundredths() prints a value given in hundredths right-aligned in a column of "width" characters    **
+** with 2 decimals, without using floating point                                                                  **
+*******************************************************************************************************************/
+void printHundredths(const uint32_t hundredths, const uint8_t width) {        // Print right-aligned, 2 decimals  //
+  uint8_t digits = 4;                                                         // Digits, point and 2 decimals     //
+  for(uint32_t i=hundredths/100;i>=10;i/=10) digits++;                        // Count the digits before the point//
+  for(uint8_t i=digits;i<width;i++) Serial.print(' ');                        // Pad to the column width          //
+  Serial.print(hundredths/100);                                               // Print the whole part             //
+  Serial.print('.');                                                          //                                  //
+  if (hundredths%100<10) Serial.print('0');                                   // and the decimals                 //
+  Serial.print(hundredths%100);                                               //                                  //
+} // of method printHundredths()                                              //                                  //
+/*******************************************************************************************************************
+** Method measure() calls a method REPEATS times and prints the average time, transactions and bytes per call     **
+*******************************************************************************************************************/
+void measure(const __FlashStringHelper *name, void (*call)(),                 // Time a method and show the       //
+             const uint16_t repeats=REPEATS) {                                // averages per call                //
+  counter.resetCounters();                                                    // Reset the counters               //
+  uint32_t startMicros = micros();                                            // Start of the calls               //
+  for(uint16_t i=0;i<repeats;i++) call();                                     // Call the method                  //
+  uint32_t elapsed     = micros()-startMicros;                                // Time taken by all calls          //
+  printHundredths(elapsed*100/repeats,10);                                    // Show the averages                //
+  printHundredths(counter.getTransactions()*100/repeats,9);                   //                                  //
+  printHundredths(counter.getBytes()*100/repeats,9);                          //                                  //
+  Serial.print(F("  "));                                                      //                                  //
+  Serial.println(name);                                                       // and the method                   //
+} // of method measure()                                                      //                                  //
+/*******************************************************************************************************************
+** Method setup(). This is an Arduino IDE method which is called first upon initial boot or restart. All of the   **
+** measurements are done here once                                                                                **
+*******************************************************************************************************************/
+void setup() {                                                                //                                  //
+  Serial.begin(SERIAL_SPEED);                                                 // Start serial communications      //
+  #ifdef  __AVR_ATmega32U4__                                                  // If we are a 32U4 processor, then //
+    delay(2000);                                                              // wait 2 seconds for the serial    //
+  #endif                                                                      // interface to initialize          //
+  Serial.print(F("\n\nINA226 Benchmark V1.0.1\n"));                           // Display program information      //
+  #ifdef SIMULATE_INA226                                                      // Add the simulated devices        //
+    for(uint8_t i=0;i<INA_SIM_MAX_DEVICES;i++) bus.addDevice(0x40+i);         //                                  //
+  #endif                                                                      //                                  //
+  INA226.setTransport(counter);                                               // Count all bus traffic            //
+  Serial.print(F("   us/call  tx/call bytes/call method\n"));                 // Display the column headings      //
+  measure(F("begin() first call"),                                            // Find, reset and calibrate the    //
+          [](){devicesFound=INA226.begin(1,100000);},1);                      // devices once                     //
+  Serial.print(F(" - Detected "));                                            //                                  //
+  Serial.print(devicesFound);                                                 //                                  //
+  Serial.println(F(" INA226 devices"));                                       //                                  //
+  if (devicesFound==0) return;                                                // Nothing to measure, no devices   //
+  INA226.configure(1,0,0,INA_MODE_CONTINUOUS_BOTH);                           // Single 140us conversions         //
+  for(uint8_t speed=0;speed<3;speed++) {                                      // Loop for each bus clock          //
+    INA226.setI2CSpeed(BUS_SPEEDS[speed]);                                    // Set the bus clock                //
+    Serial.print(F("\nI2C clock "));                                          //                                  //
+    Serial.print(BUS_SPEEDS[speed]);                                          //                                  //
+    Serial.print(F("Hz\n   us/call  tx/call bytes/call method\n"));           //                                  //
+    measure(F("begin()"),[](){INA226.begin(1,100000);});                      // Calibration only                 //
+    measure(F("getBusMilliVolts()"),[](){INA226.getBusMilliVolts();});        // Getters                          //
+    measure(F("getShuntMicroVolts()"),[](){INA226.getShuntMicroVolts();});    //                                  //
+    measure(F("getBusMicroAmps()"),[](){INA226.getBusMicroAmps();});          //                                  //
+    measure(F("getBusMicroWatts()"),[](){INA226.getBusMicroWatts();});        //                                  //
+    measure(F("getAllReadings()"),[](){INA226.getAllReadings(readings);});    //                                  //
+    measure(F("getRawSample()"),[](){INA226.getRawSample(sample);});          //                                  //
+    measure(F("startRawSample()"),                                            // Background read, waiting for it  //
+            [](){INA226.startRawSample(sample);                               // to complete when the transport   //
+                while (INA226.rawSamplePending());});                         // transfers in the background      //
+    measure(F("getRawShunt()"),[](){INA226.getRawShunt();});                  // Raw register getters             //
+    measure(F("getRawBus()"),[](){INA226.getRawBus();});                      //                                  //
+    measure(F("getRawCurrent()"),[](){INA226.getRawCurrent();});              //                                  //
+    measure(F("getRawPower()"),[](){INA226.getRawPower();});                  //                                  //
+    measure(F("getMode()"),[](){INA226.getMode();});                          //                                  //
+    measure(F("getAlertLimitType()"),[](){INA226.getAlertLimitType();});      //                                  //
+    measure(F("conversionReady()"),[](){INA226.conversionReady();});          // Waiting for conversions          //
+    measure(F("waitForConversion()"),[](){INA226.waitForConversion(0);});     //                                  //
+    measure(F("getBusMilliVolts(true)"),[](){INA226.getBusMilliVolts(true);});//                                  //
+    measure(F("setMode()"),[](){INA226.setMode(INA_MODE_CONTINUOUS_BOTH);});  // Setters, all devices             //
+    measure(F("setAveraging()"),[](){INA226.setAveraging(1);});               //                                  //
+    measure(F("setBusConversion()"),[](){INA226.setBusConversion(0);});       //                                  //
+    measure(F("setShuntConversion()"),[](){INA226.setShuntConversion(0);});   //                                  //
+    measure(F("configure()"),[](){INA226.configure(1,0,0);});                 //                                  //
+    measure(F("setAlertLimit()"),                                             //                                  //
+            [](){INA226.setAlertLimit(INA_ALERT_OFF,0);});                    //                                  //
+    measure(F("setAlertPinOnConversion()"),                                   //                                  //
+            [](){INA226.setAlertPinOnConversion(false);});                    //                                  //
+    measure(F("setAlertPolarity()"),[](){INA226.setAlertPolarity(false);});   //                                  //
+    measure(F("setAlertLatch()"),[](){INA226.setAlertLatch(false);});         //                                  //
+    measure(F("setTrim()"),[](){INA226.setTrim(0);});                         //                                  //
+    measure(F("triggerAll()"),[](){INA226.triggerAll();});                    //                                  //
+  } // of for-next each bus clock                                             //                                  //
+} // of method setup()                                                        //                                  //
+/*******************************************************************************************************************
+** This is the main program for the Arduino IDE, it is called in an infinite loop. All measurements are done in   **
+** setup() so there is nothing left to do                                                                         **
+*******************************************************************************************************************/
+void loop() {                                                                 // Main program loop                //
+} // of method loop                                                           //----------------------------------//
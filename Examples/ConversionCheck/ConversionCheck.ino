@@ -0,0 +1,244 @@
+/*******************************************************************************************************************
+** Program to check the fixed-point conversions of the INA226 library over their full range. For every maximum    **
+** current from 1 to 255 Amps given to begin(), every possible current and power register value is converted with **
+** INA226_Class::convertSample() and compared with the exact result computed using 64 bit division. A conversion  **
+** fails if it differs from the exact value by more than 1 part in 65536 plus 1 unit, or if the exact value is    **
+** beyond INT32_MAX and the result does not saturate there.                                                       **
+**                                                                                                                **
+** A second check compares the readings with the physical values instead of the library's own formula. For each   **
+** current range the simulated shunt is sized for 80mV at full scale, and shunt voltages across that range are    **
+** converted by the simulated device. The current read has to be within 0.1% plus 1 current LSB of shunt voltage  **
+** divided by shunt resistance, and the power likewise of bus voltage times that current. The current alert       **
+** limits are checked in the same way, an over and an under limit at half of full scale have to fire at 60% and   **
+** stay quiet at 40% of the full scale shunt voltage, or the other way round. A setTrim() offset of 1% of full    **
+** scale has to lower the current read by that many microamps. INA226_Statistics is given conversions at plus and **
+** minus 60% of full scale, so the minimum, maximum and root mean square have to match the current of Ohm's law   **
+** with the mean 0. Finally a conversion at 60% of full scale is added to INA226_Energy for about one second, and **
+** the charge and energy have to be within 0.1% plus 1 unit of current and power times the time integrated        **
+**                                                                                                                **
+** Detailed documentation can be found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki      **
+**                                                                                                                **
+** The program uses a simulated INA226 from INA226_Sim.h, so no device needs to be connected. It makes over 33    **
+** million conversions and each exact value needs a 64 bit division, so on an 8 bit processor it takes several    **
+** hours. The number of failures is shown for each current range which has any, followed by the total             **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+** Vers.  Date       Developer                     Comments                                                       **
+** ====== ========== ============================= ============================================================== **
+** 1.0.5  2026-10-14 https://github.com/SV-Zanshin Added check of the INA226_Statistics current summary           **
+** 1.0.4  2026-10-14 https://github.com/SV-Zanshin Added check of the setTrim() offset                            **
+** 1.0.3  2026-10-14 https://github.com/SV-Zanshin Added check of the INA226_Energy charge and energy             **
+** 1.0.2  2026-10-14 https://github.com/SV-Zanshin Added check of the current alert limits                        **
+** 1.0.1  2026-10-14 https://github.com/SV-Zanshin Added check against shunt voltage divided by resistance        **
+** 1.0.0  2026-10-14 https://github.com/SV-Zanshin Created example                                                **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include <INA226.h>                                                           // INA226 Library                   //
+#include <INA226_Sim.h>                                                       // Simulated INA226 devices         //
+#include <INA226_Energy.h>                                                    // Energy and charge accumulator    //
+#include <INA226_Statistics.h>                                                // Min/max/mean/RMS of readings     //
+/*******************************************************************************************************************
+** Declare program Constants                                                                                      **
+*******************************************************************************************************************/
+const uint32_t SERIAL_SPEED       = 115200;                                   // Use fast serial speed            //
+const uint32_t SHUNT_MICRO_OHM    = 100000;                                   // 0.1 Ohm, doesn't affect the LSBs //
+const int32_t  FULL_SCALE_UV      =  80000;                                   // Shunt voltage at maximum current //
+const int32_t  SHUNT_STEP_UV      =   2500;                                   // Shunt voltage steps checked      //
+const uint16_t BUS_MILLI_VOLTS    =  12000;                                   // Bus voltage of physical check    //
+const uint16_t ENERGY_SAMPLES     =   3600;                                   // Conversions added, about 1s      //
+/*******************************************************************************************************************
+** Declare global variables and instantiate classes                                                               **
+*******************************************************************************************************************/
+INA226_SimTransport sim;                                                      // Simulated device                 //
+INA226_Class        INA226;                                                   // INA class instantiation          //
+INA226_Energy       energy(INA226);                                           // Energy of the simulated device   //
+INA226_Statistics   statistics(INA226);                                       // Readings of the simulated device //
+/*******************************************************************************************************************
+** Method withinTolerance() returns true if a converted value is no more than 1 part in 65536 plus 1 unit away    **
+** from the exact value, with the exact value saturated to the int32_t range first                                **
+*******************************************************************************************************************/
+bool withinTolerance(const int32_t result, int64_t exact) {                   // Compare with the exact result    //
+  if (exact>INT32_MAX) exact = INT32_MAX;                                     // Results saturate at the int32_t  //
+  if (exact<INT32_MIN) exact = INT32_MIN;                                     // range                            //
+  int64_t difference = (int64_t)result-exact;                                 // Error of the conversion          //
+  if (difference<0) difference = -difference;                                 //                                  //
+  int64_t tolerance  = (exact<0 ? -exact : exact)/65536+1;                    // 15ppm plus 1 unit                //
+  return difference<=tolerance;                                               //                                  //
+} // of method withinTolerance()                                              //                                  //
+/*******************************************************************************************************************
+** Method withinAccuracy() returns true if a reading is no more than 0.1%, the accuracy of the INA226, plus the   **
+** step of one register bit away from the physical value                                                          **
+*******************************************************************************************************************/
+bool withinAccuracy(const int32_t result, const int64_t exact,                // Compare with the physical value  //
+                    const uint32_t lsb) {                                     // LSB in nA or nW                  //
+  int64_t difference = (int64_t)result-exact;                                 // Error of the reading             //
+  if (difference<0) difference = -difference;                                 //                                  //
+  int64_t tolerance  = (exact<0 ? -exact : exact)/1000+lsb/1000+1;            // 0.1% plus 1 LSB                  //
+  return difference<=tolerance;                                               //                                  //
+} // of method withinAccuracy()                                               //                                  //
+/*******************************************************************************************************************
+** Method convertInputs() sets the voltages measured by the simulated device and waits for a triggered conversion **
+** of them                                                                                                        **
+*******************************************************************************************************************/
+void convertInputs(const int32_t shuntMicroVolts) {                           // Convert the given shunt voltage  //
+  sim.setInputs(0,shuntMicroVolts,BUS_MILLI_VOLTS);                           // Apply the voltages and convert   //
+  INA226.setMode(INA_MODE_TRIGGERED_BOTH);                                    // them                             //
+  INA226.waitForConversion();                                                 //                                  //
+} // of method convertInputs()                                                //                                  //
+/*******************************************************************************************************************
+** Method alertFails() returns true unless a current alert limit at half of full scale fires for 60% and doesn't  **
+** for 40% of the full scale shunt voltage "limit", or the other way round for an under limit                     **
+*******************************************************************************************************************/
+bool alertFails(const uint8_t alertType, const uint8_t maxAmps,               // Check a current alert limit      //
+                const int32_t limit) {                                        //                                  //
+  INA226.setAlertLimit(alertType,(int32_t)maxAmps*500000);                    // Limit in uA at half of full scale//
+  convertInputs(limit*6/10);                                                  // Over the limit                   //
+  bool over  = INA226.getAlertLimitType()!=INA_ALERT_OFF;                     //                                  //
+  convertInputs(limit*4/10);                                                  // Under the limit                  //
+  bool under = INA226.getAlertLimitType()!=INA_ALERT_OFF;                     //                                  //
+  INA226.setAlertLimit(INA_ALERT_OFF,0);                                      // Disable the alert again          //
+  if (alertType==INA_ALERT_CURRENT_OVER) return !over || under;               // Only the expected one may fire   //
+  return over || !under;                                                      //                                  //
+} // of method alertFails()                                                   //                                  //
+/*******************************************************************************************************************
+** Method offsetFails() returns true unless a setTrim() offset of 1% of full scale lowers the current read for a  **
+** conversion of "shunt" by that many microamps, within 0.1% plus the rounding of the offset and of the reading   **
+** to register units                                                                                              **
+*******************************************************************************************************************/
+bool offsetFails(const int32_t shunt, const uint8_t maxAmps,                  // Check the setTrim() offset       //
+                 const uint32_t microOhmR) {                                  //                                  //
+  int32_t offset = (int32_t)maxAmps*10000;                                    // 1% of full scale in uA           //
+  INA226.setTrim(0,offset);                                                   //                                  //
+  convertInputs(shunt);                                                       //                                  //
+  int64_t amps = (int64_t)shunt*1000000/microOhmR-offset;                     // Ohm's law less the offset in uA  //
+  bool failed  = !withinAccuracy(INA226.getBusMicroAmps(),amps,               //                                  //
+                                 2*INA226.getCurrentLSB());                   //                                  //
+  INA226.setTrim(0,0);                                                        // Remove the trim again            //
+  return failed;                                                              //                                  //
+} // of method offsetFails()                                                  //                                  //
+/*******************************************************************************************************************
+** Method statisticsFails() returns true unless the INA226_Statistics summary of a conversion of "shunt" and one  **
+** of the same voltage reversed has the currents of Ohm's law as minimum, maximum and root mean square, a mean of **
+** 0 and the bus voltage                                                                                          **
+*******************************************************************************************************************/
+bool statisticsFails(const int32_t shunt, const uint32_t microOhmR) {         // Check the statistics summary     //
+  inaRawSample sample;                                                        // Register values of one conversion//
+  inaSummary   summary;                                                       // Converted statistics             //
+  statistics.reset();                                                         //                                  //
+  convertInputs(shunt);                                                       // Add a conversion of the voltage  //
+  INA226.getRawSample(sample);                                                //                                  //
+  statistics.add(sample);                                                     //                                  //
+  convertInputs(-shunt);                                                      // and one of it reversed           //
+  INA226.getRawSample(sample);                                                //                                  //
+  statistics.add(sample);                                                     //                                  //
+  statistics.getSummary(summary);                                             //                                  //
+  int64_t  amps = (int64_t)shunt*1000000/microOhmR;                           // Ohm's law for the current in uA  //
+  uint32_t lsb  = INA226.getCurrentLSB();                                     //                                  //
+  return !withinAccuracy(summary.minBusMicroAmps,-amps,lsb)  ||               // Check the current                //
+         !withinAccuracy(summary.maxBusMicroAmps,amps,lsb)   ||               //                                  //
+         !withinAccuracy(summary.rmsBusMicroAmps,amps,lsb)   ||               //                                  //
+         !withinAccuracy(summary.meanBusMicroAmps,0,lsb)     ||               //                                  //
+         !withinAccuracy(summary.meanBusMilliVolts,BUS_MILLI_VOLTS,0);        // and bus voltage                  //
+} // of method statisticsFails()                                              //                                  //
+/*******************************************************************************************************************
+** Method energyFails() returns true unless the charge and energy integrated by INA226_Energy from a conversion   **
+** of "shunt" agree with the current from Ohm's law and the bus voltage over the time integrated                  **
+*******************************************************************************************************************/
+bool energyFails(const int32_t shunt, const uint32_t microOhmR) {             // Check the energy accumulator     //
+  inaRawSample sample;                                                        // Register values of one conversion//
+  convertInputs(shunt);                                                       //                                  //
+  INA226.getRawSample(sample);                                                //                                  //
+  energy.reset();                                                             // Add the same conversion again and//
+  for(uint16_t i=0;i<ENERGY_SAMPLES;i++) energy.add(sample);                  // again                            //
+  int64_t time   = energy.getMicroSeconds();                                  // Time integrated                  //
+  int64_t amps   = (int64_t)shunt*1000000/microOhmR;                          // Ohm's law for the current in uA  //
+  int64_t charge = amps*time/INA_MICROS_PER_HOUR;                             // Exact charge in uAh              //
+  int64_t watts  = (amps<0 ? -amps : amps)*BUS_MILLI_VOLTS/1000;              // and energy in uWh                //
+  int64_t work   = watts*time/INA_MICROS_PER_HOUR;                            //                                  //
+  return !withinAccuracy(energy.getMicroAmpHours(),charge,0) ||               //                                  //
+         !withinAccuracy(energy.getMicroWattHours(),work,0);                  //                                  //
+} // of method energyFails()                                                  //                                  //
+/*******************************************************************************************************************
+** Method setup(). This is an Arduino IDE method which is called first upon initial boot or restart. All of the   **
+** checks are done here once                                                                                      **
+*******************************************************************************************************************/
+void setup() {                                                                //                                  //
+  Serial.begin(SERIAL_SPEED);                                                 // Start serial communications      //
+  #ifdef  __AVR_ATmega32U4__                                                  // If we are a 32U4 processor, then //
+    delay(2000);                                                              // wait 2 seconds for the serial    //
+  #endif                                                                      // interface to initialize          //
+  Serial.print(F("\n\nINA226 Conversion Check V1.0.5\n"));                    // Display program information      //
+  sim.addDevice(0x40);                                                        // One simulated device is enough   //
+  INA226.setTransport(sim);                                                   //                                  //
+  uint32_t failures = 0;                                                      // Conversions out of tolerance     //
+  for(uint16_t maxAmps=1;maxAmps<=255;maxAmps++) {                            // Loop for each current range      //
+    INA226.begin(maxAmps,SHUNT_MICRO_OHM);                                    // Compute the LSBs and multipliers //
+    uint32_t currentLSB = INA226.getCurrentLSB();                             //                                  //
+    uint32_t powerLSB   = INA226.getPowerLSB();                               //                                  //
+    uint32_t failed     = 0;                                                  // Failures in this range           //
+    inaRawSample sample = {};                                                 // Sample to convert                //
+    inaReadings  readings;                                                    // Converted values                 //
+    for(uint32_t raw=0;raw<=UINT16_MAX;raw++) {                               // Loop for each register value     //
+      sample.power   = raw;                                                   // Power is unsigned and current    //
+      sample.current = (int16_t)raw;                                          // signed, so both cover all values //
+      INA226.convertSample(sample,readings);                                  //                                  //
+      int64_t watts = (int64_t)sample.power*powerLSB/INA_POWER_DIVISOR;       // Exact values using 64 bit        //
+      int64_t amps  = (int64_t)sample.current*currentLSB/INA_CURRENT_DIVISOR; // division                         //
+      if (!withinTolerance(readings.busMicroWatts,watts)) failed++;           // Check power                      //
+      if (!withinTolerance(readings.busMicroAmps,amps))   failed++;           // and current                      //
+    } // of for-next each register value                                      //                                  //
+    if (failed) {                                                             // Show the ranges with failures    //
+      Serial.print(maxAmps);                                                  //                                  //
+      Serial.print(F("A: "));                                                 //                                  //
+      Serial.print(failed);                                                   //                                  //
+      Serial.println(F(" failures"));                                         //                                  //
+    } // of if-then failures                                                  //                                  //
+    failures += failed;                                                       //                                  //
+  } // of for-next each current range                                         //                                  //
+  INA226.configure(1,0,0,INA_MODE_TRIGGERED_BOTH);                            // Single 140us conversions         //
+  for(uint16_t maxAmps=1;maxAmps<=255;maxAmps++) {                            // Loop for each current range      //
+    uint32_t microOhmR = FULL_SCALE_UV/maxAmps;                               // Shunt for 80mV at full scale     //
+    int32_t  limit     = maxAmps*microOhmR/SHUNT_STEP_UV*SHUNT_STEP_UV;       // Steps up to maximum current      //
+    INA226.begin(maxAmps,microOhmR);                                          //                                  //
+    uint32_t currentLSB = INA226.getCurrentLSB();                             //                                  //
+    uint32_t powerLSB   = INA226.getPowerLSB();                               //                                  //
+    uint32_t failed     = 0;                                                  // Failures in this range           //
+    for(int32_t shunt=-limit;shunt<=limit;shunt+=SHUNT_STEP_UV) {             // Loop for each shunt voltage      //
+      convertInputs(shunt);                                                   // Measure the shunt voltage        //
+      int64_t amps  = (int64_t)shunt*1000000/microOhmR;                       // Ohm's law for the current in uA  //
+      int64_t watts = (amps<0 ? -amps : amps)*BUS_MILLI_VOLTS/1000;           // and power in uW, which saturates //
+      if (watts>INT32_MAX) watts = INT32_MAX;                                 // at the int32_t range             //
+      if (!withinAccuracy(INA226.getBusMicroAmps(),amps,currentLSB))          // Check current                    //
+        failed++;                                                             //                                  //
+      if (!withinAccuracy(INA226.getBusMicroWatts(),watts,powerLSB))          // and power                        //
+        failed++;                                                             //                                  //
+    } // of for-next each shunt voltage                                       //                                  //
+    if (alertFails(INA_ALERT_CURRENT_OVER,maxAmps,limit))  failed++;          // Check the current alert limits   //
+    if (alertFails(INA_ALERT_CURRENT_UNDER,maxAmps,limit)) failed++;          //                                  //
+    if (offsetFails(limit*6/10,maxAmps,microOhmR)) failed++;                  // Check the trim offset            //
+    if (statisticsFails(limit*6/10,microOhmR))     failed++;                  // Check the statistics             //
+    if (energyFails(limit*6/10,microOhmR)) failed++;                          // Check the energy and charge      //
+    if (failed) {                                                             // Show the ranges with failures    //
+      Serial.print(maxAmps);                                                  //                                  //
+      Serial.print(F("A physical: "));                                        //                                  //
+      Serial.print(failed);                                                   //                                  //
+      Serial.println(F(" failures"));                                         //                                  //
+    } // of if-then failures                                                  //                                  //
+    failures += failed;                                                       //                                  //
+  } // of for-next each current range                                         //                                  //
+  Serial.print(failures ? F("FAIL, ") : F("PASS, "));                         // Show the result                  //
+  Serial.print(failures);                                                     //                                  //
+  Serial.println(F(" failures in total"));                                    //                                  //
+} // of method setup()                                                        //                                  //
+/*******************************************************************************************************************
+** This is the main program for the Arduino IDE, it is called in an infinite loop. All checks are done in setup() **
+** so there is nothing left to do                                                                                 **
+*******************************************************************************************************************/
+void loop() {                                                                 // Main program loop                //
+} // of method loop                                                           //----------------------------------//
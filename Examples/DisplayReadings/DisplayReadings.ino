@@ -11,12 +11,10 @@
 ** only to convert and display the data conveniently. The INA226 uses 15 bits of precision, and even though the   **
 ** current and watt information is returned using 32-bit integers the precision remains the same.                 **
 **                                                                                                                **
-** As of version 1.0.3 the library supports multiple INA226 devices.  The Atmel's EEPROM is used to store the 96  **
-** bytes of static information per device using https://www.arduino.cc/en/Reference/EEPROM function calls.        **
-** Although up to 16 devices could theoretically be present on the I2C bus the actual limit is determined by the  **
-** available EEPROM - ATmega328 UNO has 1024k so can support up to 10 devices but the ATmega168 only has 512 bytes**
-** which limits it to supporting at most 5 INA226s.  The library has been modified to be backwards compatible and **
-** the device number (from 0 to number of devices found) is passed as the last parameter.                         **
+** As of version 1.0.3 the library supports multiple INA226 devices. The static information for each device is    **
+** held in RAM, up to INA_MAX_DEVICES devices, and can optionally be stored in and restored from EEPROM using the **
+** saveDevices() and loadDevices() calls. The library has been modified to be backwards compatible and the device **
+** number (from 0 to number of devices found) is passed as the last parameter.                                    **
 **                                                                                                                **
 ** The datasheet for the INA226 can be found at http://www.ti.com/lit/ds/symlink/ina226.pdf and it contains the   **
 ** information required in order to hook up the device. Unfortunately it comes as a VSSOP package but it can be   **
@@ -34,6 +32,7 @@
 **                                                                                                                **
 ** Vers.  Date       Developer                     Comments                                                       **
 ** ====== ========== ============================= ============================================================== **
+** 1.0.6  2026-10-14 https://github.com/SV-Zanshin Use configure() to set up all devices with one write each      **
 ** 1.0.5  2018-06-08 https://github.com/SV-Zanshin removed unneeded prototype definitions                         **
 ** 1.0.4  2018-06-01 https://github.com/SV-Zanshin https://github.com/SV-Zanshin/INA226/issues/11 Corrected loop  **
 ** 1.0.3  2017-09-18 https://github.com/SV-Zanshin https://github.com/SV-Zanshin/INA226/issues/6 Multiple INA226s **
@@ -62,7 +61,7 @@ void setup() {                                                                //
   #ifdef  __AVR_ATmega32U4__                                                  // If we are a 32U4 processor, then //
     delay(2000);                                                              // wait 2 seconds for the serial    //
   #endif                                                                      // interface to initialize          //
-  Serial.print(F("\n\nDisplay INA226 Readings V1.0.5\n"));                    // Display program information      //
+  Serial.print(F("\n\nDisplay INA226 Readings V1.0.6\n"));                    // Display program information      //
   Serial.print(F(" - Searching & Initializing INA226\n"));                    // Display program information      //
   // The begin initializes the calibration for an expected ±1 Amps maximum current and for a 0.1Ohm resistor, and //
   // since no specific device is given as the 3rd parameter all devices are initially set to these values         //
@@ -70,10 +69,9 @@ void setup() {                                                                //
   Serial.print(F(" - Detected "));                                            //                                  //
   Serial.print(devicesFound);                                                 //                                  //
   Serial.println(F(" INA226 devices on I2C bus"));                            //                                  //
-  INA226.setAveraging(4);                                                     // Average each reading n-times     //
-  INA226.setBusConversion(7);                                                 // Maximum conversion time 8.244ms  //
-  INA226.setShuntConversion(7);                                               // Maximum conversion time 8.244ms  //
-  INA226.setMode(INA_MODE_CONTINUOUS_BOTH);                                   // Bus/shunt measured continuously  //
+  INA226.configure(4,7,7,INA_MODE_CONTINUOUS_BOTH);                           // Average 4 readings, maximum 8.244//
+                                                                              // ms conversions, bus and shunt    //
+                                                                              // measured continuously            //
 } // of method setup()                                                        //                                  //
 /*******************************************************************************************************************
 ** This is the main program for the Arduino IDE, it is called in an infinite loop. The INA226 measurements are    **
@@ -0,0 +1,119 @@
+/*******************************************************************************************************************
+** Program to measure the highest sustained sample rate the INA226 library achieves with 1 up to all of the       **
+** devices found, for a range of conversion times and at the standard, fast and fast mode plus bus clocks.        **
+**                                                                                                                **
+** Detailed documentation can be found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki      **
+**                                                                                                                **
+** All devices convert continuously without averaging. For each combination the program polls the devices in turn **
+** for MEASURE_MILLIS, reading all four registers of each device with getRawSample() whenever conversionReady()   **
+** reports a new result. The table shows the samples per second achieved, the rate the conversions alone would    **
+** allow, the percentage of that reached and the I2C transactions per sample. Once the bus and processor can no   **
+** longer keep up the percentage drops below 100, showing the bus clock or the conversion time needed for a given **
+** number of devices and sample rate.                                                                             **
+**                                                                                                                **
+** Defining SIMULATE_INA226 runs the program against INA226_SimTransport devices instead, which works on a board  **
+** without any INA226 connected, although the bus clock then makes no difference.                                 **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+** Vers.  Date       Developer                     Comments                                                       **
+** ====== ========== ============================= ============================================================== **
+** 1.0.1  2026-10-14 https://github.com/SV-Zanshin Use the library's INA226_CountingTransport                     **
+** 1.0.0  2026-10-14 https://github.com/SV-Zanshin Created example                                                **
+**                                                                                                                **
+*******************************************************************************************************************/
+// #define SIMULATE_INA226                                                    // Uncomment for simulated devices  //
+#include <INA226.h>                                                           // INA226 Library                   //
+#include <INA226_Sim.h>                                                       // Simulated INA226 devices         //
+/*******************************************************************************************************************
+** Declare program Constants                                                                                      **
+*******************************************************************************************************************/
+const uint32_t SERIAL_SPEED       = 115200;                                   // Use fast serial speed            //
+const uint32_t MEASURE_MILLIS     =   1000;                                   // Time each combination is sampled //
+const uint32_t BUS_SPEEDS[3]      = {INA_I2C_STANDARD_MODE,INA_I2C_FAST_MODE, // I2C clocks measured              //
+                                     INA_I2C_FAST_MODE_PLUS};                 //                                  //
+const uint8_t  CONVERSION_TIMES[4]= {0,2,4,7};                                // 140us, 332us, 1.1ms and 8.244ms  //
+/*******************************************************************************************************************
+** Declare global variables and instantiate classes                                                               **
+*******************************************************************************************************************/
+#ifdef SIMULATE_INA226                                                        // Either simulated devices or the  //
+  INA226_SimTransport  bus;                                                   // real ones on the "Wire" bus      //
+#else                                                                         //                                  //
+  INA226_WireTransport bus;                                                   //                                  //
+#endif                                                                        //                                  //
+INA226_CountingTransport counter(bus);                                        // Counts the bus traffic           //
+INA226_Class             INA226;                                              // INA class instantiation          //
+uint8_t                  devicesFound = 0;                                    // Number of INA226s found          //
+/*******************************************************************************************************************
+** Method measure() samples the first "devices" devices for MEASURE_MILLIS and prints one line of the table       **
+*******************************************************************************************************************/
+void measure(const uint8_t devices) {                                         // Find the sustained sample rate   //
+  inaRawSample sample;                                                        // Unconverted register values      //
+  uint32_t samples     = 0;                                                   // Samples taken                    //
+  counter.resetCounters();                                                    // Reset the counters               //
+  uint32_t startMillis = millis();                                            // Start of the measurement         //
+  while (millis()-startMillis<MEASURE_MILLIS) {                               // Loop for the measurement time    //
+    for(uint8_t i=0;i<devices;i++) {                                          // Poll each device in turn         //
+      if (INA226.conversionReady(i)) {                                        // If it has a new result           //
+        INA226.getRawSample(sample,i);                                        // read all 4 registers             //
+        samples++;                                                            // and count the sample             //
+      } // of if-then new result                                              //                                  //
+    } // for-next each device                                                 //                                  //
+  } // of while measuring                                                     //                                  //
+  uint32_t rate    = samples*1000/MEASURE_MILLIS;                             // Samples per second achieved      //
+  uint32_t maximum = devices*1000000/INA226.getConversionMicros();            // Samples/s the conversions allow  //
+  Serial.print(INA226.getConversionMicros());                                 // Display the table line           //
+  Serial.print(F("us\t"));                                                    //                                  //
+  Serial.print(devices);                                                      //                                  //
+  Serial.print('\t');                                                         //                                  //
+  Serial.print(rate);                                                         //                                  //
+  Serial.print('\t');                                                         //                                  //
+  Serial.print(maximum);                                                      //                                  //
+  Serial.print('\t');                                                         //                                  //
+  Serial.print((float)rate*100/maximum,2);                                    //                                  //
+  Serial.print(F("%\t"));                                                     //                                  //
+  Serial.print(samples ? (float)counter.getTransactions()/samples : 0,2);     //                                  //
+  Serial.println();                                                           //                                  //
+} // of method measure()                                                      //                                  //
+/*******************************************************************************************************************
+** Method setup(). This is an Arduino IDE method which is called first upon initial boot or restart. All of the   **
+** measurements are done here once                                                                                **
+*******************************************************************************************************************/
+void setup() {                                                                //                                  //
+  Serial.begin(SERIAL_SPEED);                                                 // Start serial communications      //
+  #ifdef  __AVR_ATmega32U4__                                                  // If we are a 32U4 processor, then //
+    delay(2000);                                                              // wait 2 seconds for the serial    //
+  #endif                                                                      // interface to initialize          //
+  Serial.print(F("\n\nINA226 Sample Rate V1.0.1\n"));                         // Display program information      //
+  #ifdef SIMULATE_INA226                                                      // Add the simulated devices        //
+    for(uint8_t i=0;i<INA_SIM_MAX_DEVICES;i++) bus.addDevice(0x40+i);         //                                  //
+  #endif                                                                      //                                  //
+  INA226.setTransport(counter);                                               // Count all bus traffic            //
+  devicesFound = INA226.begin(1,100000);                                      // Set expected Amps and resistor   //
+  Serial.print(F(" - Detected "));                                            //                                  //
+  Serial.print(devicesFound);                                                 //                                  //
+  Serial.println(F(" INA226 devices"));                                       //                                  //
+  for(uint8_t speed=0;speed<3;speed++) {                                      // Loop for each bus clock          //
+    INA226.setI2CSpeed(BUS_SPEEDS[speed]);                                    // Set the bus clock                //
+    Serial.print(F("\nI2C clock "));                                          //                                  //
+    Serial.print(BUS_SPEEDS[speed]);                                          //                                  //
+    Serial.print(F("Hz\nconv\tdevices\tsamples/s\tmaximum\t"));               // Display the column headings      //
+    Serial.print(F("reached\ttx/sample\n"));                                  //                                  //
+    for(uint8_t conv=0;conv<4;conv++) {                                       // Loop for each conversion time    //
+      INA226.configure(1,CONVERSION_TIMES[conv],CONVERSION_TIMES[conv],       // Set all devices, which starts    //
+                       INA_MODE_CONTINUOUS_BOTH);                             // a new conversion on each one     //
+      for(uint8_t devices=1;devices<=devicesFound;devices++) measure(devices);// Measure 1 up to all devices      //
+    } // of for-next each conversion time                                     //                                  //
+  } // of for-next each bus clock                                             //                                  //
+} // of method setup()                                                        //                                  //
+/*******************************************************************************************************************
+** This is the main program for the Arduino IDE, it is called in an infinite loop. All measurements are done in   **
+** setup() so there is nothing left to do                                                                         **
+*******************************************************************************************************************/
+void loop() {                                                                 // Main program loop                //
+} // of method loop                                                           //----------------------------------//
@@ -14,121 +14,468 @@
 *******************************************************************************************************************/
 #include "INA226.h"                                                           // Include the header definition    //
 #include <Wire.h>                                                             // I2C Library definition           //
-#include <EEPROM.h>                                                           // Include the EEPROM library       //
+volatile bool INA226_Class::_AlertFlag        = false;                        // Static alert interrupt variables //
+volatile uint32_t INA226_Class::_AlertMicros  = 0;                            //                                  //
+uint8_t       INA226_Class::_AlertPin         = UINT8_MAX;                    // shared by all class instances    //
+void        (*INA226_Class::_AlertUserHandler)(void) = NULL;                  //                                  //
 INA226_Class::INA226_Class()  {}                                              // Class constructor                //
 INA226_Class::~INA226_Class() {}                                              // Unused class destructor          //
 /*******************************************************************************************************************
 ** Method begin() sets the INA226 Configuration details, without which meaningful readings cannot be made. If it  **
 ** is called without the option deviceNumber parameter then the settings are applied to all devices, otherwise    **
-** just that specific device is targeted.                                                                         **
+** just that specific device is targeted. The optional i2cSpeed parameter sets the I2C clock when the devices are **
+** first enumerated, e.g. INA_I2C_FAST_MODE or INA_I2C_FAST_MODE_PLUS where supported by the hardware             **
 *******************************************************************************************************************/
 uint8_t INA226_Class::begin(const uint8_t maxBusAmps,                         // Class initializer                //
                             const uint32_t microOhmR,                         //                                  //
-                            const uint8_t deviceNumber ) {                    //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  uint16_t manufacturerId;                                                    // Read manufacturerId from device  //
-  if (_DeviceCount==0) {                                                      // Enumerate devices in first call  //
-    Wire.begin();                                                             // Start the I2C wire subsystem     //
-    for(uint8_t deviceAddress = 64;deviceAddress<79;deviceAddress++) {        // Loop for each possible address   //
-      Wire.beginTransmission(deviceAddress);                                  // See if something is at address   //
-      if (Wire.endTransmission() == 0) {                                      // by checking the return error     //
-        if (readWord(INA_MANUFACTURER_ID_REGISTER,deviceAddress)==0x5449) {   // Check hard-coded manufacturerId  //
-          writeWord(INA_CONFIGURATION_REGISTER,INA_RESET_DEVICE,deviceAddress);// Force INAs to reset             //
-          delay(I2C_DELAY);                                                   // Wait for INA to finish resetting //
-          if (readWord(INA_CONFIGURATION_REGISTER,deviceAddress)              // Yes, we've found an INA226!      //
-              ==INA_DEFAULT_CONFIGURATION) {                                  //                                  //
-            ina.address       = deviceAddress;                                // Store device address             //
-            ina.operatingMode = B111;                                         // Default to continuous mode       //
-            if ((_DeviceCount*sizeof(ina))<EEPROM.length()) {                 // If there's space left in EEPROM  //
-              EEPROM.put(_DeviceCount*sizeof(ina),ina);                       // Add the structure                //
-              _DeviceCount++;                                                 // Increment the device counter     //
-            } // of if-then the values will fit into EEPROM                   //                                  //
-          } // of if-then we have identified a INA226                         //                                  //
-        } // of if-then we have identified a INA226 manufacturer code         //                                  //
-      } // of if-then we have found a live device                             //                                  //
-    } // for-next each possible I2C address                                   //                                  //
-  } // of if-then first call with no devices found                            //                                  //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values for device    //
-  ina.current_LSB = (uint64_t)maxBusAmps*1000000000/32767;                    // Get the best possible LSB in nA  //
-  ina.calibration = (uint64_t)51200000 / ((uint64_t)ina.current_LSB *         // Compute calibration register     //
-                    (uint64_t)microOhmR / (uint64_t)100000);                  // using 64 bit numbers throughout  //
-  ina.power_LSB   = (uint32_t)25*ina.current_LSB;                             // Fixed multiplier for INA219      //
-  #ifdef debug_Mode                                                           // Display values when debugging    //
-  Serial.print(F("current_LSB = ")); Serial.println(ina.current_LSB);         //                                  //
-  Serial.print(F("calibration = ")); Serial.println(ina.calibration);         //                                  //
-  Serial.print(F("power_LSB   = ")); Serial.println(ina.power_LSB);           //                                  //
-  #endif                                                                      // end of conditional compile code  //
-  if (deviceNumber==UINT8_MAX) {                                              // If default value, then set all   //
-    for(uint8_t i=0;i<_DeviceCount;i++) {                                     // For each device write data       //
-      EEPROM.put(i*sizeof(ina),ina);                                          // Write value to address           //
-      writeWord(INA_CALIBRATION_REGISTER,ina.calibration,ina.address);        // Write the calibration value      //
-    } // of for each device                                                   //                                  //
-  } else {                                                                    //                                  //
-    EEPROM.put((deviceNumber%_DeviceCount)*sizeof(ina),ina);                  // Write struct, cater for overflow //
-    writeWord(INA_CALIBRATION_REGISTER,ina.calibration,ina.address);          // Write the calibration value      //
-  } // of if-then-else set one or all devices                                 //                                  //
+                            const uint8_t deviceNumber,                       //                                  //
+                            const uint32_t i2cSpeed ) {                       //                                  //
+  if (discover(i2cSpeed)==0) return _DeviceCount;                             // Nothing to do if no devices found//
+  uint32_t current_LSB = (uint64_t)maxBusAmps*1000000000/32767;               // Get the best possible LSB in nA  //
+  uint16_t calibration = (uint64_t)51200000 / ((uint64_t)current_LSB *        // Compute calibration register     //
+                         (uint64_t)microOhmR / (uint64_t)100000);             // using 64 bit numbers throughout  //
+  uint32_t power_LSB   = (uint32_t)25*current_LSB;                            // Fixed multiplier for INA219      //
+  setCalibration(calibration,current_LSB,power_LSB,deviceNumber);             // Store and write calibration      //
   return _DeviceCount;                                                        // Return number of devices found   //
 } // of method begin()                                                        //                                  //
 /*******************************************************************************************************************
+** Method discover() starts the I2C buses and enumerates the INA226 devices the first time it is called, later    **
+** calls do nothing. Each bus added with addBus(), or "Wire" if there are none, is searched in turn. If           **
+** setDiscovery() was given a list of addresses only those are checked, otherwise all of the possible addresses   **
+** 0x40-0x4F. Each address is first probed with an empty write which isn't treated as an error, so an absent      **
+** device neither sets getLastError() nor is logged. Devices are identified by their manufacturer ID and then,    **
+** unless disabled with setDiscovery(), all are reset back-to-back followed by one shared settling delay. Devices **
+** that aren't reset keep their settings, which are read into the shadow registers. Returns the number of devices **
+** found                                                                                                          **
+*******************************************************************************************************************/
+uint8_t INA226_Class::discover(const uint32_t i2cSpeed) {                     // Find and reset all devices       //
+  if (_DeviceCount) return _DeviceCount;                                      // Only enumerate in first call     //
+  uint8_t candidates = _Addresses ? _AddressCount : INA_ADDRESS_COUNT;        // Number of addresses to check     //
+  for(uint8_t bus=0;bus<busCount();bus++) {                                   // Loop for each I2C bus            //
+    transport(bus).begin(i2cSpeed);                                           // Start the bus at the given speed //
+    for(uint8_t i=0;i<candidates && _DeviceCount<INA_MAX_DEVICES;i++) {       // Loop while space left in table   //
+      inaDet &ina = _Device[_DeviceCount];                                    // Fill the next free table entry   //
+      ina.address = _Addresses ? _Addresses[i] : INA_FIRST_ADDRESS+i;         // Address from list or scan range  //
+      ina.bus     = bus;                                                      // Bus the device is connected to   //
+      ina.pointer = INA_UNKNOWN_POINTER;                                      // Register pointer not yet known   //
+      beginAccess(ina);                                                       // Claim the bus for the probe      //
+      bool present = transport(bus).write(ina.address,NULL,0,true)==0;        // See if something is at address   //
+      endAccess(ina);                                                         // Release the bus                  //
+      if (!present) continue;                                                 // Skip address if nothing answered //
+      if ((uint16_t)readWord(INA_MANUFACTURER_ID_REGISTER,ina)==0x5449 &&     // Check hard-coded manufacturerId  //
+          ina.status==INA_STATUS_OK) {                                        // of a device that answered        //
+        _DeviceCount++;                                                       // Keep the table entry             //
+      } // of if-then we have identified a INA226 manufacturer code           //                                  //
+    } // for-next each candidate address                                      //                                  //
+  } // for-next each bus                                                      //                                  //
+  if (_ResetOnBegin) {                                                        // If the devices are to be reset   //
+    for(uint8_t i=0;i<_DeviceCount;i++)                                       // Reset all devices back-to-back   //
+      writeWord(INA_CONFIGURATION_REGISTER,INA_RESET_DEVICE,_Device[i]);      // so they reboot together          //
+    delay(I2C_DELAY);                                                         // Wait once for all to finish      //
+  } // of if-then reset devices                                               //                                  //
+  uint8_t found = 0;                                                          // Devices which passed all checks  //
+  for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
+    inaDet &ina = _Device[i];                                                 // Reference device details in RAM  //
+    ina.configuration = readWord(INA_CONFIGURATION_REGISTER,ina);             // Read the current settings into   //
+    bool answered     = ina.status==INA_STATUS_OK;                            // the shadow registers, checking   //
+    ina.maskEnable    = readWord(INA_MASK_ENABLE_REGISTER,ina);               // that all reads worked            //
+    answered          = answered && ina.status==INA_STATUS_OK;                //                                  //
+    ina.alertLimit    = readWord(INA_ALERT_LIMIT_REGISTER,ina);               //                                  //
+    answered          = answered && ina.status==INA_STATUS_OK;                //                                  //
+    ina.maskEnable   &= ~INA_MASK_FLAGS;                                      // Only keep the settings bits      //
+    if (answered &&                                                           // If the device has answered and,  //
+        (!_ResetOnBegin || ina.configuration==INA_DEFAULT_CONFIGURATION)) {   // if reset, has default settings   //
+      _Device[found++] = ina;                                                 // then we've found an INA226!      //
+    } // of if-then we have identified a INA226                               //                                  //
+  } // for-next each device                                                   //                                  //
+  _DeviceCount = found;                                                       // Store the final number           //
+  #ifdef INA_ENABLE_STATS                                                     //                                  //
+    resetStats();                                                             // Don't count the enumeration      //
+  #endif                                                                      //                                  //
+  return _DeviceCount;                                                        // Return number of devices found   //
+} // of method discover()                                                     //                                  //
+/*******************************************************************************************************************
+** Method addBus adds an I2C bus, e.g. Wire1 on processors with more than one, to be searched by begin() and has  **
+** to be called before it. The first call replaces the default "Wire" bus, so to use both "Wire" and "Wire1" each **
+** has to be added. Up to INA_MAX_BUSES buses can be added, returns false if there is no space left               **
+*******************************************************************************************************************/
+bool INA226_Class::addBus(TwoWire &bus) {                                     // Add an I2C bus to search         //
+  if (_BusCount>=INA_MAX_BUSES) return false;                                 // Return if no space left          //
+  _WireTransport[_BusCount].setWire(bus);                                     // Default transport uses this bus  //
+  _Bus[_BusCount++] = &bus;                                                   // Store the bus                    //
+  return true;                                                                // Return success                   //
+} // of method addBus()                                                       //                                  //
+/*******************************************************************************************************************
+** Method busCount returns the number of I2C buses in use, which is 1 for the default "Wire" bus if addBus()      **
+** hasn't been called                                                                                             **
+*******************************************************************************************************************/
+uint8_t INA226_Class::busCount() {                                            // Number of I2C buses in use       //
+  return _BusCount ? _BusCount : 1;                                           // Default "Wire" if none added     //
+} // of method busCount()                                                     //                                  //
+/*******************************************************************************************************************
+** Method writeMaskEnable changes the bits selected by "mask" in the shadow copy of the mask/enable register of   **
+** one or all devices to "value" and writes the register                                                          **
+*******************************************************************************************************************/
+void INA226_Class::writeMaskEnable(const uint16_t mask, const uint16_t value, // Change bits of the mask/enable   //
+                                   const uint8_t deviceNumber) {              // register of one or all devices   //
+  for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
+    if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
+      inaDet &ina = _Device[i];                                               // Reference device details in RAM  //
+      ina.maskEnable = (ina.maskEnable&~mask)|(value&mask);                   // Change the bits                  //
+      writeWord(INA_MASK_ENABLE_REGISTER,ina.maskEnable,ina);                 // Write register to device         //
+    } // of if this device needs to be set                                    //                                  //
+  } // for-next each device loop                                              //                                  //
+} // of method writeMaskEnable()                                              //                                  //
+/*******************************************************************************************************************
+** Method getDeviceBus returns the I2C bus a device is connected to                                               **
+*******************************************************************************************************************/
+TwoWire& INA226_Class::getDeviceBus(const uint8_t deviceNumber) {             // Return I2C bus of a device       //
+  return *_Bus[device(deviceNumber).bus];                                     // Return stored value              //
+} // of method getDeviceBus()                                                 //                                  //
+/*******************************************************************************************************************
+** Methods getCurrentLSB and getPowerLSB return the LSB values computed by begin() and corrected by setTrim(), in **
+** nA and nW per register bit, and getCurrentOffset returns the offset set by setTrim() in current register       **
+** units. They allow register values to be converted elsewhere, e.g. by INA226_Energy, as (current-               **
+** offset)*current_LSB/INA_CURRENT_DIVISOR uA and power*power_LSB/INA_POWER_DIVISOR uW                            **
+*******************************************************************************************************************/
+uint32_t INA226_Class::getCurrentLSB(const uint8_t deviceNumber) {            // Return current LSB set by begin()//
+  return device(deviceNumber).current_LSB;                                    // Return stored value              //
+} // of method getCurrentLSB()                                                //                                  //
+uint32_t INA226_Class::getPowerLSB(const uint8_t deviceNumber) {              // Return power LSB set by begin()  //
+  return device(deviceNumber).power_LSB;                                      // Return stored value              //
+} // of method getPowerLSB()                                                  //                                  //
+int16_t INA226_Class::getCurrentOffset(const uint8_t deviceNumber) {          // Return offset set by setTrim()   //
+  return device(deviceNumber).currentOffset;                                  // Return stored value              //
+} // of method getCurrentOffset()                                             //                                  //
+/*******************************************************************************************************************
+** Method setTrim corrects the current and power readings of one or all devices for the actual shunt resistance   **
+** and offset, e.g. measured in production against a reference meter. "gainPPM" is the error of the readings in   **
+** parts per million, positive if they are too low, and "offsetMicroAmps" the current in uA read with no load,    **
+** which is subtracted from the current readings. As much of the gain as possible goes into the calibration       **
+** register, so the current and power registers and alert limits of the device are corrected in hardware. What is **
+** left of it from rounding the register value goes into the current and power LSBs and the fixed-point           **
+** multipliers, and the offset is converted to register units, rounded towards zero, and subtracted before the    **
+** multiplication, so a trimmed reading costs no more than an untrimmed one. The trim is relative to the values   **
+** from begin() and is kept by saveDevices(), so it can be changed at any time, e.g. to follow the temperature    **
+** drift of the shunt. The register values themselves are not offset-corrected, but the current alert limits and  **
+** the INA226_Energy and INA226_Statistics totals use getCurrentOffset() to take it into account. INA226_Fixed    **
+** only gets the part which is in the calibration register                                                        **
+*******************************************************************************************************************/
+void INA226_Class::setTrim(const int32_t gainPPM,                             // Correct the gain and offset of   //
+                           const int32_t offsetMicroAmps,                     // the current measured             //
+                           const uint8_t deviceNumber) {                      //                                  //
+  int32_t gain = 1000000+constrain(gainPPM,-500000,500000);                   // Correction factor in ppm         //
+  for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
+    if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
+      inaDet &ina = _Device[i];                                               // Reference device details in RAM  //
+      if (ina.nominalCalibration==0 || ina.current_LSB==0) continue;          // Skip if begin() wasn't called    //
+      uint64_t target = (uint64_t)ina.nominalCalibration*gain;                // Trimmed calibration in ppm       //
+      uint16_t calibration = constrain((target+500000)/1000000,1,0x7FFF);     // Nearest register value           //
+      uint64_t divisor     = (uint64_t)calibration*1000000;                   // The rounding goes into the LSB   //
+      uint32_t current_LSB = (target*ina.nominal_LSB+divisor/2)/divisor;      //                                  //
+      ina.power_LSB     = (25*target*ina.nominal_LSB+divisor/2)/divisor;      // Power LSB is 25 * current LSB    //
+      ina.current_LSB   = current_LSB;                                        //                                  //
+      ina.calibration   = calibration;                                        //                                  //
+      int64_t  offset   = (int64_t)offsetMicroAmps*INA_CURRENT_DIVISOR;       // Offset from uA to nA, then to    //
+      ina.currentOffset = constrain(offset/current_LSB,INT16_MIN,INT16_MAX);  // register units                   //
+      scaleFactors(ina);                                                      // Precompute the conversions again //
+      writeWord(INA_CALIBRATION_REGISTER,calibration,ina);                    // Write the calibration value      //
+      #if INA_LOG_LEVEL>=INA_LOG_INFO                                         // Log the trimmed values           //
+        logValue(ina,F("current_LSB = "),ina.current_LSB);                    //                                  //
+        logValue(ina,F("calibration = "),calibration);                        //                                  //
+        logValue(ina,F("offset      = "),ina.currentOffset);                  //                                  //
+      #endif                                                                  //                                  //
+    } // of if this device needs to be set                                    //                                  //
+  } // for-next each device loop                                              //                                  //
+} // of method setTrim()                                                      //                                  //
+/*******************************************************************************************************************
+** Method setTransport replaces the transport used for one of the I2C buses, by default the Arduino "Wire"        **
+** library, with another implementation of INA226_Transport such as a DMA driver. The bus has to be "Wire" or     **
+** one added with addBus(), and the call has to come before begin(). Returns false if the bus isn't in use        **
+*******************************************************************************************************************/
+bool INA226_Class::setTransport(INA226_Transport &transport,                  // Replace the transport of a bus   //
+                                TwoWire &bus) {                               //                                  //
+  for(uint8_t i=0;i<busCount();i++) {                                         // Loop for each I2C bus            //
+    if (_Bus[i]==&bus) {                                                      // If this is the bus to change     //
+      _Transport[i] = &transport;                                             // store the new transport          //
+      return true;                                                            // and return success               //
+    } // of if-then bus found                                                 //                                  //
+  } // for-next each bus                                                      //                                  //
+  return false;                                                               // Return failure, bus not in use   //
+} // of method setTransport()                                                 //                                  //
+/*******************************************************************************************************************
+** Method transport returns the transport of a bus, the "Wire" transport unless setTransport() was called         **
+*******************************************************************************************************************/
+INA226_Transport& INA226_Class::transport(const uint8_t bus) {                // Return the transport of a bus    //
+  if (_Transport[bus]) return *_Transport[bus];                               // Transport set by setTransport()  //
+  return _WireTransport[bus];                                                 // or the default one               //
+} // of method transport()                                                    //                                  //
+/*******************************************************************************************************************
+** Method setDiscovery changes how begin() enumerates the devices and has to be called before it. "addresses"     **
+** is an optional array of "addressCount" known I2C addresses, which skips probing the full address range. The    **
+** array has to remain valid until begin() is called. Setting "resetDevices" to false keeps the settings of       **
+** devices which are already configured, e.g. when restarting after a watchdog reset while they keep measuring    **
+*******************************************************************************************************************/
+void INA226_Class::setDiscovery(const uint8_t addresses[],                    // Set enumeration options          //
+                                const uint8_t addressCount,                   //                                  //
+                                const bool    resetDevices) {                 //                                  //
+  _Addresses    = addressCount ? addresses : NULL;                            // Known addresses, NULL to scan    //
+  _AddressCount = addressCount;                                               // Number of known addresses        //
+  _ResetOnBegin = resetDevices;                                               // Whether to reset the devices     //
+} // of method setDiscovery()                                                 //                                  //
+/*******************************************************************************************************************
+** Method getDeviceAddress returns the I2C address of a device, e.g. to store a list for setDiscovery()           **
+*******************************************************************************************************************/
+uint8_t INA226_Class::getDeviceAddress(const uint8_t deviceNumber) {          // Return I2C address of a device   //
+  return device(deviceNumber).address;                                        // Return stored value              //
+} // of method getDeviceAddress()                                             //                                  //
+/*******************************************************************************************************************
+** Method setCalibration stores the precomputed calibration and LSB values for one or all devices and writes the  **
+** calibration register. It is used by begin() and by the INA226_Fixed template, which computes the values at     **
+** compile time. Any trim set with setTrim() is removed                                                           **
+*******************************************************************************************************************/
+void INA226_Class::setCalibration(const uint16_t calibration,                 // Store and write calibration      //
+                                  const uint32_t current_LSB,                 //                                  //
+                                  const uint32_t power_LSB,                   //                                  //
+                                  const uint8_t deviceNumber) {               //                                  //
+  for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
+    if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
+      _Device[i].current_LSB = current_LSB;                                   // Copy the computed values into    //
+      _Device[i].calibration = calibration;                                   // the device table                 //
+      _Device[i].power_LSB   = power_LSB;                                     //                                  //
+      _Device[i].nominal_LSB = current_LSB;                                   // Keep the untrimmed values for    //
+      _Device[i].nominalCalibration = calibration;                            // setTrim() and remove any trim    //
+      _Device[i].currentOffset      = 0;                                      //                                  //
+      scaleFactors(_Device[i]);                                               // Precompute the conversions so no //
+                                                                              // division is needed when reading  //
+      writeWord(INA_CALIBRATION_REGISTER,calibration,_Device[i]);             // Write the calibration value      //
+      #if INA_LOG_LEVEL>=INA_LOG_INFO                                         // Log the values computed by begin //
+        logValue(_Device[i],F("current_LSB = "),current_LSB);                 //                                  //
+        logValue(_Device[i],F("calibration = "),calibration);                 //                                  //
+        logValue(_Device[i],F("power_LSB   = "),power_LSB);                   //                                  //
+      #endif                                                                  //                                  //
+    } // of if this device needs to be set                                    //                                  //
+  } // for-next each device loop                                              //                                  //
+} // of method setCalibration()                                               //                                  //
+/*******************************************************************************************************************
+** Method scaleFactors precomputes the current and power conversions of a device from its LSB values. Rounding    **
+** the power multiplier up, or a large unshifted one, can take the product of a big power register value beyond   **
+** INT32_MAX, so the largest register value that still converts into range is computed as well and scalePower()   **
+** saturates above it                                                                                             **
+*******************************************************************************************************************/
+void INA226_Class::scaleFactors(inaDet &ina) {                                // Precompute conversions of device //
+  scaleFactor(ina.current_LSB,INA_CURRENT_DIVISOR,                            // Multipliers and shifts for the   //
+              ina.currentMultiplier,ina.currentShift);                        // current and power registers      //
+  scaleFactor(ina.power_LSB,INA_POWER_DIVISOR,                                //                                  //
+              ina.powerMultiplier,ina.powerShift);                            //                                  //
+  uint64_t limit = UINT16_MAX;                                                // Largest register value in range  //
+  if (ina.powerMultiplier)                                                    // is the largest product in range  //
+    limit = ((((uint64_t)INT32_MAX+1)<<ina.powerShift)-1)/ina.powerMultiplier;// divided by the multiplier        //
+  ina.powerLimit = limit>UINT16_MAX ? UINT16_MAX : limit;                     //                                  //
+} // of method scaleFactors()                                                 //                                  //
+/*******************************************************************************************************************
+** Method scaleFactor computes "multiplier" and "shift" so that (raw*multiplier)>>shift approximates raw*lsb/     **
+** divisor. The quotient is computed one bit at a time using 32 bit arithmetic only, adding binary places until   **
+** the multiplier has 16 significant bits, and the last bit is rounded. A signed 16 bit register value times the  **
+** multiplier then fits into 32 bits. The rounding error of the multiplier is at most 1 part in 65536 (15ppm,     **
+** well below the 0.1% accuracy of the INA226) so the result differs from the exact 64 bit division by no more    **
+** than 15ppm of the value plus 1 unit (uA or uW). Multipliers above 16 bits before the binary point are unshifted**
+*******************************************************************************************************************/
+void INA226_Class::scaleFactor(const uint32_t lsb, const uint32_t divisor,    // Compute fixed-point multiplier   //
+                               uint32_t &multiplier, uint8_t &shift) {        // and shift for lsb/divisor        //
+  multiplier         = lsb/divisor;                                           // Integer part of the quotient     //
+  uint32_t remainder = lsb%divisor;                                           // and what is left over            //
+  shift              = 0;                                                     //                                  //
+  while (multiplier<32768 && shift<30) {                                      // Add bits until 16 significant    //
+    remainder  <<= 1;                                                         // Long division, the remainder is  //
+    multiplier <<= 1;                                                         // always less than divisor so this //
+    if (remainder>=divisor) {                                                 // cannot overflow                  //
+      multiplier |= 1;                                                        //                                  //
+      remainder  -= divisor;                                                  //                                  //
+    } // of if-then next bit is set                                           //                                  //
+    shift++;                                                                  // One more binary place            //
+  } // of while more bits needed                                              //                                  //
+  if (remainder*2>=divisor) multiplier++;                                     // Round the last bit               //
+} // of method scaleFactor()                                                  //                                  //
+/*******************************************************************************************************************
+** Methods scaleCurrent and scalePower convert a register value using the precomputed multiplier and shift. To    **
+** match the integer division they replace, negative values are truncated towards zero. The current offset set    **
+** with setTrim() is subtracted first, limited to the range of the register. Power beyond INT32_MAX uW saturates  **
+*******************************************************************************************************************/
+int32_t INA226_Class::scaleCurrent(const int16_t raw, const inaDet &ina) {    // Convert current register to uA   //
+  int32_t product = constrain((int32_t)raw-ina.currentOffset,INT16_MIN,       // Remove the offset and do a 32 bit//
+                              INT16_MAX)*(int32_t)ina.currentMultiplier;      // multiply                         //
+  if (product<0) return -(int32_t)((uint32_t)-product>>ina.currentShift);     // and shift, truncating to zero    //
+  return product>>ina.currentShift;                                           //                                  //
+} // of method scaleCurrent()                                                 //                                  //
+int32_t INA226_Class::scalePower(const uint16_t raw, const inaDet &ina) {     // Convert power register to uW     //
+  if (raw>ina.powerLimit) return INT32_MAX;                                   // Saturate if out of range, else   //
+  return ((uint32_t)raw*ina.powerMultiplier)>>ina.powerShift;                 // 32 bit multiply and shift        //
+} // of method scalePower()                                                   //                                  //
+/*******************************************************************************************************************
+** Method checkStatus stores the result of an I2C operation in the device details. Keeping the status per device  **
+** means that devices on different buses can be accessed from different tasks. A failure is also kept in          **
+** _LastError until it has been retrieved with getLastError(), and leaves the register pointer state of the       **
+** device unknown. Returns true if the operation succeeded                                                        **
+*******************************************************************************************************************/
+bool INA226_Class::checkStatus(const uint8_t status, inaDet &ina) {           // Store I2C result, true if success//
+  ina.status = status;                                                        // Store the status of this call    //
+  if (status) {                                                               // If the operation failed then     //
+    _LastError  = status;                                                     // keep the error for getLastError()//
+    ina.pointer = INA_UNKNOWN_POINTER;                                        // and the pointer is now unknown   //
+    #ifdef INA_ENABLE_STATS                                                   //                                  //
+      _Stats[&ina-_Device].failures++;                                        // Count the failure                //
+    #endif                                                                    //                                  //
+    #if INA_LOG_LEVEL>=INA_LOG_ERROR                                          //                                  //
+      logValue(ina,F("I2C error = "),status);                                 // Log the failed transfer          //
+    #endif                                                                    //                                  //
+  } // of if-then the operation failed                                        //                                  //
+  return status==0;                                                           // Return true if successful        //
+} // of method checkStatus()                                                  //                                  //
+/*******************************************************************************************************************
+** Methods countTransfer and countWait add to the statistics of a device when the library is compiled with        **
+** INA_ENABLE_STATS defined, otherwise they are empty and removed by the compiler. countTransfer adds the number  **
+** of transactions and of data bytes, plus one address byte per transaction. countWait adds the polls of a        **
+** waitForConversion() call and keeps the longest wait                                                            **
+*******************************************************************************************************************/
+void INA226_Class::countTransfer(const inaDet &ina,                           // Count I2C transactions and bytes //
+                                 const uint8_t transactions,                  //                                  //
+                                 const uint8_t bytes) {                       //                                  //
+  #ifdef INA_ENABLE_STATS                                                     //                                  //
+    inaStats &stats = _Stats[&ina-_Device];                                   // Statistics of the device         //
+    stats.transactions += transactions;                                       // Count transactions               //
+    stats.bytes        += transactions+bytes;                                 // and bytes, including address     //
+  #else                                                                       //                                  //
+    (void)ina; (void)transactions; (void)bytes;                               // Parameters unused without stats  //
+  #endif                                                                      //                                  //
+} // of method countTransfer()                                                //                                  //
+void INA226_Class::countWait(const inaDet &ina, const uint32_t spins,         // Count waitForConversion() polls  //
+                             const uint32_t microSeconds) {                   //                                  //
+  #ifdef INA_ENABLE_STATS                                                     //                                  //
+    inaStats &stats = _Stats[&ina-_Device];                                   // Statistics of the device         //
+    stats.waitSpins += spins;                                                 // Count the polls                  //
+    if (microSeconds>stats.maxWaitMicros) stats.maxWaitMicros = microSeconds; // and keep the longest wait        //
+  #else                                                                       //                                  //
+    (void)ina; (void)spins; (void)microSeconds;                               // Parameters unused without stats  //
+  #endif                                                                      //                                  //
+} // of method countWait()                                                    //                                  //
+/*******************************************************************************************************************
+** Methods beginAccess and endAccess enclose every I2C transaction with a device. beginAccess clears the status   **
+** of the device so that it only reflects the call being made and, if a lock handler has been set with            **
+** setBusLock(), asks it to claim the device's bus. endAccess asks the handler to release the bus again           **
+*******************************************************************************************************************/
+void INA226_Class::beginAccess(inaDet &ina) {                                 // Claim bus, clear device status   //
+  if (_BusLock) _BusLock(*_Bus[ina.bus],true);                                // Lock the bus if a handler is set //
+  ina.status = INA_STATUS_OK;                                                 // Status of this transaction only  //
+} // of method beginAccess()                                                  //                                  //
+void INA226_Class::endAccess(inaDet &ina) {                                   // Release the bus                  //
+  if (_BusLock) _BusLock(*_Bus[ina.bus],false);                               // Unlock bus if a handler is set   //
+} // of method endAccess()                                                    //                                  //
+/*******************************************************************************************************************
+** Method setPointer writes the register pointer of the device if it isn't already pointing at "addr". The INA226 **
+** keeps the pointer between reads, so consecutive reads of the same register only need the 2 data bytes. An      **
+** unsuccessful transmission leaves the pointer state unknown so that it is written again on the next access      **
+*******************************************************************************************************************/
+void INA226_Class::setPointer(const uint8_t addr, inaDet &ina) {              // Set the register pointer         //
+  if (ina.pointer==addr) return;                                              // Nothing to do if already set     //
+  countTransfer(ina,1,1);                                                     // Count for the statistics         //
+  if (checkStatus(transport(ina.bus).write(ina.address,&addr,1,true),ina))    // Send the register address and    //
+    ina.pointer = addr;                                                       // remember the pointer if success  //
+  if (_I2CDelay) delayMicroseconds(_I2CDelay);                                // Optional delay before the read   //
+} // of method setPointer()                                                   //                                  //
+/*******************************************************************************************************************
 ** Method readByte reads 1 byte from the specified address                                                        **
 *******************************************************************************************************************/
-uint8_t INA226_Class::readByte(const uint8_t addr,const uint8_t deviceAddr){  //                                  //
-  Wire.beginTransmission(deviceAddr);                                         // Address the I2C device           //
-  Wire.write(addr);                                                           // Send the register address to read//
-  _TransmissionStatus = Wire.endTransmission();                               // Close transmission               //
-  delayMicroseconds(I2C_DELAY);                                               // delay required for sync          //
-  Wire.requestFrom(deviceAddr, (uint8_t)1);                                   // Request 1 byte of data           //
-  return Wire.read();                                                         // read it and return it            //
+uint8_t INA226_Class::readByte(const uint8_t addr, inaDet &ina) {             //                                  //
+  uint8_t returnData = 0;                                                     // Return value, 0 if not received  //
+  beginAccess(ina);                                                           // Claim the bus for the transaction//
+  setPointer(addr,ina);                                                       // Send the register address to read//
+  countTransfer(ina,1,1);                                                     // Count for the statistics         //
+  if (transport(ina.bus).read(ina.address,&returnData,1,true)!=1)             // Request 1 byte of data           //
+    checkStatus(INA_STATUS_READ_ERROR,ina);                                   // Flag error if the read fails     //
+  endAccess(ina);                                                             // Release the bus                  //
+  return returnData;                                                          // and return it                    //
 } // of method readByte()                                                     //                                  //
 /*******************************************************************************************************************
 ** Method readWord reads 2 bytes from the specified address                                                       **
 *******************************************************************************************************************/
-int16_t INA226_Class::readWord(const uint8_t addr,const uint8_t deviceAddr){  //                                  //
-  int16_t returnData;                                                         // Store return value               //
-  Wire.beginTransmission(deviceAddr);                                         // Address the I2C device           //
-  Wire.write(addr);                                                           // Send the register address to read//
-  _TransmissionStatus = Wire.endTransmission();                               // Close transmission               //
-  delayMicroseconds(I2C_DELAY);                                               // delay required for sync          //
-  Wire.requestFrom(deviceAddr, (uint8_t)2);                                   // Request 2 consecutive bytes      //
-  returnData = Wire.read();                                                   // Read the msb                     //
-  returnData = returnData<<8;                                                 // shift the data over              //
-  returnData|= Wire.read();                                                   // Read the lsb                     //
-  return returnData;                                                          // read it and return it            //
+int16_t INA226_Class::readWord(const uint8_t addr, inaDet &ina) {             //                                  //
+  uint8_t data[2] = {0,0};                                                    // Received msb and lsb, 0 if not   //
+  beginAccess(ina);                                                           // Claim the bus for the transaction//
+  setPointer(addr,ina);                                                       // Send the register address to read//
+  countTransfer(ina,1,2);                                                     // Count for the statistics         //
+  if (transport(ina.bus).read(ina.address,data,2,true)!=2)                    // Request 2 consecutive bytes      //
+    checkStatus(INA_STATUS_READ_ERROR,ina);                                   // Flag error if the read fails     //
+  endAccess(ina);                                                             // Release the bus                  //
+  return (int16_t)(data[0]<<8|data[1]);                                       // Combine msb and lsb, return it   //
 } // of method readWord()                                                     //                                  //
 /*******************************************************************************************************************
+** Method readWords reads "count" consecutive registers starting at "addr" into the "data" array. The INA226 does **
+** not auto-increment its register pointer, so each register still needs a pointer write, but all of the reads    **
+** are chained with repeated starts into one bus transaction without any intervening stop conditions or delays    **
+*******************************************************************************************************************/
+void INA226_Class::readWords(const uint8_t addr, int16_t *data,               // Read consecutive registers using //
+                             const uint8_t count, inaDet &ina) {              // repeated starts                  //
+  INA226_Transport &bus = transport(ina.bus);                                 // Transport of the device's bus    //
+  uint8_t bytes[2];                                                           // Received msb and lsb             //
+  beginAccess(ina);                                                           // Claim the bus for the transaction//
+  for(uint8_t i=0;i<count;i++) {                                              // Loop for each register to read   //
+    bool lastRegister = (i==count-1);                                         // Only send a stop after the last  //
+    if (ina.pointer!=addr+i) {                                                // Only write the pointer if needed //
+      uint8_t reg = addr+i;                                                   // Register address to read         //
+      countTransfer(ina,1,1);                                                 // Count for the statistics         //
+      if (checkStatus(bus.write(ina.address,&reg,1,false),ina))               // Repeated start, keep bus and     //
+        ina.pointer = reg;                                                    // remember the pointer if success  //
+    } // of if-then pointer needs to be set                                   //                                  //
+    countTransfer(ina,1,2);                                                   // Count for the statistics         //
+    if (bus.read(ina.address,bytes,2,lastRegister)!=2)                        // Request 2 consecutive bytes      //
+      checkStatus(INA_STATUS_READ_ERROR,ina);                                 // Flag error if the read fails     //
+    data[i] = (int16_t)(bytes[0]<<8|bytes[1]);                                // Combine msb and lsb              //
+  } // for-next each register                                                 //                                  //
+  endAccess(ina);                                                             // Release the bus                  //
+} // of method readWords()                                                    //                                  //
+/*******************************************************************************************************************
 ** Method writeByte write 1 byte to the specified address                                                         **
 *******************************************************************************************************************/
 void INA226_Class::writeByte(const uint8_t addr, const uint8_t data,          //                                  //
-                             const uint8_t deviceAddr) {                      //                                  //
-  Wire.beginTransmission(deviceAddr);                                         // Address the I2C device           //
-  Wire.write(addr);                                                           // Send register address to write   //
-  Wire.write(data);                                                           // Send the data to write           //
-  _TransmissionStatus = Wire.endTransmission();                               // Close transmission               //
+                             inaDet &ina) {                                   //                                  //
+  uint8_t bytes[2] = {addr,data};                                             // Register address and the data    //
+  beginAccess(ina);                                                           // Claim the bus for the transaction//
+  countTransfer(ina,1,2);                                                     // Count for the statistics         //
+  if (checkStatus(transport(ina.bus).write(ina.address,bytes,2,true),ina))    // Send register address and data,  //
+    ina.pointer = addr;                                                       // a write also sets the pointer    //
+  endAccess(ina);                                                             // Release the bus                  //
 } // of method writeByte()                                                    //                                  //
 /*******************************************************************************************************************
 ** Method writeWord writes 2 byte to the specified address                                                        **
 *******************************************************************************************************************/
 void INA226_Class::writeWord(const uint8_t addr, const uint16_t data,         //                                  //
-                            const uint8_t deviceAddr) {                       //                                  //
-  Wire.beginTransmission(deviceAddr);                                         // Address the I2C device           //
-  Wire.write(addr);                                                           // Send register address to write   //
-  Wire.write((uint8_t)(data>>8));                                             // Write the first byte             //
-  Wire.write((uint8_t)data);                                                  // and then the second              //
-  _TransmissionStatus = Wire.endTransmission();                               // Close transmission               //
+                             inaDet &ina) {                                   //                                  //
+  uint8_t bytes[3] = {addr,(uint8_t)(data>>8),(uint8_t)data};                 // Register address, msb and lsb    //
+  beginAccess(ina);                                                           // Claim the bus for the transaction//
+  countTransfer(ina,1,3);                                                     // Count for the statistics         //
+  if (checkStatus(transport(ina.bus).write(ina.address,bytes,3,true),ina))    // Send register address and data,  //
+    ina.pointer = addr;                                                       // a write also sets the pointer    //
+  endAccess(ina);                                                             // Release the bus                  //
 } // of method writeWord()                                                    //                                  //
 /*******************************************************************************************************************
+** Method device returns a reference to the RAM copy of the details for the given device number. Numbers beyond   **
+** the number of devices found wrap around, just as they did when the details were kept in EEPROM                 **
+*******************************************************************************************************************/
+inaDet& INA226_Class::device(const uint8_t deviceNumber) {                    // Return details for a device      //
+  return _Device[deviceIndex(deviceNumber)];                                  // Numbers out of range wrap around //
+} // of method device()                                                       //                                  //
+/*******************************************************************************************************************
 ** Method getBusMilliVolts retrieves the bus voltage measurement                                                  **
 *******************************************************************************************************************/
 uint16_t INA226_Class::getBusMilliVolts(const bool waitSwitch,                //                                  //
                                         const uint8_t deviceNumber) {         //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
-  if (waitSwitch) waitForConversion();                                        // wait for conversion to complete  //
-  uint16_t busVoltage = readWord(INA_BUS_VOLTAGE_REGISTER,ina.address);       // Get the raw value and apply      //
+  inaDet &ina = device(deviceNumber);                                         // Reference device details in RAM  //
+  if (waitSwitch) waitForConversion(deviceNumber);                            // wait for conversion to complete  //
+  uint16_t busVoltage = readWord(INA_BUS_VOLTAGE_REGISTER,ina);               // Get the raw value and apply      //
   busVoltage = (uint32_t)busVoltage*INA_BUS_VOLTAGE_LSB/100;                  // conversion to get milliVolts     //
-  if (!bitRead(ina.operatingMode,2) && bitRead(ina.operatingMode,1)) {        // If triggered mode and bus active //
-    int16_t configRegister = readWord(INA_CONFIGURATION_REGISTER,ina.address);// Get the current register         //
-    writeWord(INA_CONFIGURATION_REGISTER,configRegister,ina.address);         // Write back to trigger next       //
+  if (!bitRead(ina.configuration,2) && bitRead(ina.configuration,1)) {        // If triggered mode and bus active //
+    writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);              // Write back to trigger next       //
   } // of if-then triggered mode enabled                                      //                                  //
   return(busVoltage);                                                         // return computed milliVolts       //
 } // of method getBusMilliVolts()                                             //                                  //
@@ -137,15 +484,15 @@ uint16_t INA226_Class::getBusMilliVolts(const bool waitSwitch,                //
 *******************************************************************************************************************/
 int16_t INA226_Class::getShuntMicroVolts(const bool waitSwitch,               //                                  //
                                          const uint8_t deviceNumber) {        //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
-  if (waitSwitch) waitForConversion();                                        // wait for conversion to complete  //
-  int32_t shuntVoltage = readWord(INA_SHUNT_VOLTAGE_REGISTER,ina.address);    // Get the raw value                //
-Serial.print("shuntVoltageRaw = ");Serial.println(shuntVoltage);
+  inaDet &ina = device(deviceNumber);                                         // Reference device details in RAM  //
+  if (waitSwitch) waitForConversion(deviceNumber);                            // wait for conversion to complete  //
+  int32_t shuntVoltage = readWord(INA_SHUNT_VOLTAGE_REGISTER,ina);            // Get the raw value                //
+  #if INA_LOG_LEVEL>=INA_LOG_DEBUG                                            // Log the raw register value       //
+    logValue(ina,F("shuntVoltageRaw = "),shuntVoltage);                       //                                  //
+  #endif                                                                      //                                  //
   shuntVoltage = shuntVoltage*INA_SHUNT_VOLTAGE_LSB/10;                       // Convert to microvolts            //
-  if (!bitRead(ina.operatingMode,2) && bitRead(ina.operatingMode,0)) {        // If triggered and shunt active    //
-    int16_t configRegister = readWord(INA_CONFIGURATION_REGISTER,ina.address);// Get the current register         //
-    writeWord(INA_CONFIGURATION_REGISTER,configRegister,ina.address);         // Write back to trigger next       //
+  if (!bitRead(ina.configuration,2) && bitRead(ina.configuration,0)) {        // If triggered and shunt active    //
+    writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);              // Write back to trigger next       //
   } // of if-then triggered mode enabled                                      //                                  //
   return((int16_t)shuntVoltage);                                              // return computed microvolts       //
 } // of method getShuntMicroVolts()                                           //                                  //
@@ -153,34 +500,183 @@ Serial.print("shuntVoltageRaw = ");Serial.println(shuntVoltage);
 ** Method getBusMicroAmps retrieves the computed current in microamps.                                            **
 *******************************************************************************************************************/
 int32_t INA226_Class::getBusMicroAmps(const uint8_t deviceNumber) {           //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
-  int32_t microAmps = readWord(INA_CURRENT_REGISTER,ina.address);             // Get the raw value                //
-
-Serial.print("BusCurrentRaw = ");Serial.println(microAmps);
-          microAmps = (int64_t)microAmps*ina.current_LSB/100000;                // Convert to microamps             //
+  inaDet &ina = device(deviceNumber);                                         // Reference device details in RAM  //
+  int32_t microAmps = readWord(INA_CURRENT_REGISTER,ina);                     // Get the raw value                //
+  #if INA_LOG_LEVEL>=INA_LOG_DEBUG                                            // Log the raw register value       //
+    logValue(ina,F("BusCurrentRaw = "),microAmps);                            //                                  //
+  #endif                                                                      //                                  //
+  microAmps = scaleCurrent(microAmps,ina);                                    // Convert to microamps             //
   return(microAmps);                                                          // return computed microamps        //
 } // of method getBusMicroAmps()                                              //                                  //
 /*******************************************************************************************************************
 ** Method getBusMicroWatts retrieves the computed power in milliwatts                                             **
 *******************************************************************************************************************/
 int32_t INA226_Class::getBusMicroWatts(const uint8_t deviceNumber) {          //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
-  int32_t microWatts = readWord(INA_POWER_REGISTER,ina.address);              // Get the raw value                //
-          microWatts = (int64_t)microWatts*ina.power_LSB/1000;                // Convert to milliwatts            //
+  inaDet &ina = device(deviceNumber);                                         // Reference device details in RAM  //
+  int32_t microWatts = scalePower(readWord(INA_POWER_REGISTER,ina),ina);      // Get the value in microwatts      //
   return(microWatts);                                                         // return computed milliwatts       //
 } // of method getBusMicroWatts()                                             //                                  //
 /*******************************************************************************************************************
+** Method getAllReadings retrieves the shunt voltage, bus voltage, power and current registers together, which    **
+** are contiguous on the INA226, and converts all 4 values into the "readings" structure. In triggered mode the   **
+** next conversion is started once all values have been read                                                      **
+*******************************************************************************************************************/
+void INA226_Class::getAllReadings(inaReadings &readings,                      // Retrieve shunt, bus, power and   //
+                                  const uint8_t deviceNumber) {               // current in one bus transaction   //
+  inaRawSample sample;                                                        // Unconverted register values      //
+  getRawSample(sample,deviceNumber);                                          // Read all 4 registers             //
+  convertSample(sample,readings);                                             // and convert them                 //
+} // of method getAllReadings()                                               //                                  //
+/*******************************************************************************************************************
+** Method getRawSample retrieves the shunt voltage, bus voltage, power and current registers together without     **
+** converting them, so that the sample can be stored quickly (e.g. in an INA226_SampleBuffer) and converted later.**
+** The timestamp is the time at which the alert pin fired when setAlertInterrupt() is used, otherwise the time of **
+** the read. In triggered mode the next conversion is started once all values have been read                      **
+*******************************************************************************************************************/
+void INA226_Class::getRawSample(inaRawSample &sample,                         // Retrieve unconverted registers   //
+                                const uint8_t deviceNumber) {                 // with a timestamp                 //
+  inaDet &ina = device(deviceNumber);                                         // Reference device details in RAM  //
+  int16_t raw[4];                                                             // Raw shunt, bus, power and current//
+  sample.microSeconds = micros();                                             // Time of the read                 //
+  if (_AlertPin!=UINT8_MAX) {                                                 // If the alert interrupt is used   //
+    noInterrupts();                                                           // 32 bit value isn't atomic on AVR //
+    sample.microSeconds = _AlertMicros;                                       // use the time of the alert        //
+    interrupts();                                                             //                                  //
+  } // of if-then alert interrupt used                                        //                                  //
+  readWords(INA_SHUNT_VOLTAGE_REGISTER,raw,4,ina);                            // Read all 4 registers             //
+  sample.deviceNumber = &ina-_Device;                                         // Store the actual device number   //
+  sample.shunt        = raw[0];                                               // Store the register values        //
+  sample.bus          = raw[1];                                               //                                  //
+  sample.power        = raw[2];                                               //                                  //
+  sample.current      = raw[3];                                               //                                  //
+  if (!bitRead(ina.configuration,2) &&                                        // If triggered mode and either bus //
+      (ina.configuration&INA_MODE_TRIGGERED_BOTH)) {                          // or shunt active                  //
+    writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);              // Write back to trigger next       //
+  } // of if-then triggered mode enabled                                      //                                  //
+} // of method getRawSample()                                                 //                                  //
+/*******************************************************************************************************************
+** Method startRawSample starts reading the 4 measurement registers of a device into "sample" and returns         **
+** without waiting if the transport of its bus transfers in the background; with the default "Wire" transport     **
+** the read completes before returning. When all data has arrived the result is stored in "sample" and the        **
+** optional callback is called, possibly from within the transport's interrupt handler, and getStatus() has the   **
+** result. "sample" has to remain valid until then. Only one transfer can be in progress, the function returns    **
+** false without starting another one while rawSamplePending() is true. The next conversion in triggered mode     **
+** isn't started automatically, as the I2C bus can't be used from the completion interrupt. A lock handler set    **
+** with setBusLock() is called to claim the bus here and to release it once the transfer has completed, so the    **
+** bus stays locked for the whole background transfer and the release also happens from the completion interrupt  **
+** with transports that transfer in the background                                                                **
+*******************************************************************************************************************/
+bool INA226_Class::startRawSample(inaRawSample &sample,                       // Start background register read   //
+                                  void (*callback)(inaRawSample &sample),     //                                  //
+                                  const uint8_t deviceNumber) {               //                                  //
+  if (_Pending) return false;                                                 // Only one transfer at a time      //
+  inaDet &ina = device(deviceNumber);                                         // Reference device details in RAM  //
+  sample.microSeconds = micros();                                             // Time of the read                 //
+  sample.deviceNumber = &ina-_Device;                                         // Store the actual device number   //
+  _PendingSample       = &sample;                                             // Remember where the result goes   //
+  _PendingCallback     = callback;                                            //                                  //
+  _Pending             = true;                                                // Mark transfer as in progress     //
+  beginAccess(ina);                                                           // Claim the bus to start transfer  //
+  ina.pointer = INA_UNKNOWN_POINTER;                                          // Pointer set by transfer later    //
+  bool started = transport(ina.bus).readRegisters(ina.address,                // Start reading all 4 registers    //
+                                                  INA_SHUNT_VOLTAGE_REGISTER, //                                  //
+                                                  _PendingData,4,             //                                  //
+                                                  transferDone,this);         //                                  //
+  if (started) countTransfer(ina,8,12);                                       // 4 pointer writes and 4 reads     //
+  else {                                                                      // Transport busy, so nothing is    //
+    _Pending = false;                                                         // pending and transferDone() won't //
+    endAccess(ina);                                                           // release the bus, do it here      //
+  } // of if-then-else transfer started                                       //                                  //
+  return started;                                                             // Return true if started           //
+} // of method startRawSample()                                               //                                  //
+/*******************************************************************************************************************
+** Method rawSamplePending returns true while a transfer started by startRawSample() hasn't completed             **
+*******************************************************************************************************************/
+bool INA226_Class::rawSamplePending() {                                       // Background read in progress      //
+  return _Pending;                                                            // Return the flag                  //
+} // of method rawSamplePending()                                             //                                  //
+/*******************************************************************************************************************
+** Method transferDone is called by the transport when the background read of startRawSample() has finished. It   **
+** stores the status and the register values in the sample, releases the bus claimed by startRawSample() and then **
+** calls the user's callback                                                                                      **
+*******************************************************************************************************************/
+void INA226_Class::transferDone(void *context, const uint8_t status) {        // Background read has completed    //
+  INA226_Class &ina226 = *(INA226_Class*)context;                             // Instance that started the read   //
+  inaRawSample &sample = *ina226._PendingSample;                              // Sample being read                //
+  inaDet       &ina    = ina226._Device[sample.deviceNumber];                 // Device the sample is from        //
+  const uint8_t *data  = ina226._PendingData;                                 // Received register contents       //
+  if (ina226.checkStatus(status,ina)) ina.pointer = INA_CURRENT_REGISTER;     // Last register read if success    //
+  sample.shunt   = (int16_t)(data[0]<<8|data[1]);                             // Store the register values        //
+  sample.bus     = (uint16_t)(data[2]<<8|data[3]);                            //                                  //
+  sample.power   = (uint16_t)(data[4]<<8|data[5]);                            //                                  //
+  sample.current = (int16_t)(data[6]<<8|data[7]);                             //                                  //
+  ina226.endAccess(ina);                                                      // Release the bus                  //
+  ina226._Pending = false;                                                    // Transfer is no longer in progress//
+  if (ina226._PendingCallback) ina226._PendingCallback(sample);               // Call the user's function if set  //
+} // of method transferDone()                                                 //                                  //
+/*******************************************************************************************************************
+** Methods getRawShunt, getRawBus, getRawCurrent and getRawPower return the unconverted register value, avoiding  **
+** the 64 bit arithmetic of the converting methods. Use convertSample() or convertSamples() to convert later      **
+*******************************************************************************************************************/
+int16_t INA226_Class::getRawShunt(const uint8_t deviceNumber) {               // Retrieve shunt voltage register  //
+  return readWord(INA_SHUNT_VOLTAGE_REGISTER,device(deviceNumber));           // Return register value            //
+} // of method getRawShunt()                                                  //                                  //
+uint16_t INA226_Class::getRawBus(const uint8_t deviceNumber) {                // Retrieve bus voltage register    //
+  return readWord(INA_BUS_VOLTAGE_REGISTER,device(deviceNumber));             // Return register value            //
+} // of method getRawBus()                                                    //                                  //
+int16_t INA226_Class::getRawCurrent(const uint8_t deviceNumber) {             // Retrieve current register        //
+  return readWord(INA_CURRENT_REGISTER,device(deviceNumber));                 // Return register value            //
+} // of method getRawCurrent()                                                //                                  //
+uint16_t INA226_Class::getRawPower(const uint8_t deviceNumber) {              // Retrieve power register          //
+  return readWord(INA_POWER_REGISTER,device(deviceNumber));                   // Return register value            //
+} // of method getRawPower()                                                  //                                  //
+/*******************************************************************************************************************
+** Method convertSample converts the register values of a raw sample into the "readings" structure, using the     **
+** current and power LSB values of the device the sample was read from                                            **
+*******************************************************************************************************************/
+void INA226_Class::convertSample(const inaRawSample &sample,                  // Convert a raw sample to readings //
+                                 inaReadings &readings) {                     //                                  //
+  inaDet &ina = device(sample.deviceNumber);                                  // Reference device details in RAM  //
+  readings.shuntMicroVolts = (int32_t)sample.shunt*INA_SHUNT_VOLTAGE_LSB/10;  // Convert to microvolts            //
+  readings.busMilliVolts   = (uint32_t)sample.bus*INA_BUS_VOLTAGE_LSB/100;    // Convert to millivolts            //
+  readings.busMicroWatts   = scalePower(sample.power,ina);                    // Convert to microwatts            //
+  readings.busMicroAmps    = scaleCurrent(sample.current,ina);                // Convert to microamps             //
+} // of method convertSample()                                                //                                  //
+/*******************************************************************************************************************
+** Method convertSamples converts "count" raw samples into the "readings" array, e.g. after draining a sample     **
+** buffer, so that the conversion of a whole batch can be done when the processor isn't busy sampling             **
+*******************************************************************************************************************/
+void INA226_Class::convertSamples(const inaRawSample samples[],               // Convert an array of raw samples  //
+                                  inaReadings readings[],                     //                                  //
+                                  const uint8_t count) {                      //                                  //
+  for(uint8_t i=0;i<count;i++) convertSample(samples[i],readings[i]);         // Convert each sample in turn      //
+} // of method convertSamples()                                               //                                  //
+/*******************************************************************************************************************
+** Method getDeviceCount returns the number of INA226 devices found by begin()                                    **
+*******************************************************************************************************************/
+uint8_t INA226_Class::getDeviceCount() {                                      // Return number of devices found   //
+  return _DeviceCount;                                                        // Return stored value              //
+} // of method getDeviceCount()                                               //                                  //
+/*******************************************************************************************************************
+** Method deviceIndex returns the index in the device table that a device number refers to, wrapping numbers      **
+** beyond the number of devices found around. Classes keeping their own per-device tables, such as INA226_Energy, **
+** use it so that they pick the same device as INA226_Class                                                       **
+*******************************************************************************************************************/
+uint8_t INA226_Class::deviceIndex(const uint8_t deviceNumber) {               // Table index of a device number   //
+  if (deviceNumber<_DeviceCount) return deviceNumber;                         // Avoid the division when in range //
+  if (_DeviceCount==0) return 0;                                              // Avoid division by zero           //
+  return deviceNumber%_DeviceCount;                                           // Cater for overflow of number     //
+} // of method deviceIndex()                                                  //                                  //
+/*******************************************************************************************************************
 ** Method reset resets the INA226 using the first bit in the configuration register                               **
 *******************************************************************************************************************/
 void INA226_Class::reset(const uint8_t deviceNumber) {                        // Reset the INA226                 //
-  inaDet ina;                                                                 // Hold device details in structure //
-  int16_t configRegister;                                                     // Hold configuration register      //
   for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
     if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
-      EEPROM.get(i*sizeof(ina),ina);                                          // Read EEPROM values               //
-      writeWord(INA_CONFIGURATION_REGISTER,0x8000,ina.address);               // Set most significant bit         //
+      writeWord(INA_CONFIGURATION_REGISTER,INA_RESET_DEVICE,_Device[i]);      // Set most significant bit         //
+      _Device[i].configuration = INA_DEFAULT_CONFIGURATION;                   // The registers are now back to    //
+      _Device[i].maskEnable    = 0;                                           // their power-on values            //
+      _Device[i].alertLimit    = 0;                                           //                                  //
       delay(I2C_DELAY);                                                       // Let the INA226 reboot            //
     } // of if this device needs to be set                                    //                                  //
   } // for-next each device loop                                              //                                  //
@@ -189,53 +685,66 @@ void INA226_Class::reset(const uint8_t deviceNumber) {                        //
 ** Method getMode returns the current monitoring mode of the device selected                                      **
 *******************************************************************************************************************/
 uint8_t INA226_Class::getMode(const uint8_t deviceNumber ) {                  // Return the monitoring mode       //
-  inaDet ina;                                                                 // Hold device details in structure //
-  uint8_t tempDevice = deviceNumber+1;                                        // Temporary device number storage  //
-  EEPROM.get(tempDevice*sizeof(ina),ina);                                     // Read EEPROM values               //
-  return(ina.operatingMode);                                                  // Return stored value              //
+  return(device(deviceNumber).configuration&INA_CONFIG_MODE_MASK);            // Return stored value              //
 } // of method getMode()                                                      //                                  //
 /*******************************************************************************************************************
 ** Method setMode allows the various mode combinations to be set. If no parameter is given the system goes back   **
 ** to the default startup mode.                                                                                   **
 *******************************************************************************************************************/
 void INA226_Class::setMode(const uint8_t mode,const uint8_t deviceNumber ) {  // Set the monitoring mode          //
-  inaDet ina;                                                                 // Hold device details in structure //
-  int16_t configRegister;                                                     // Hold configuration register      //
   for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
     if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
-      EEPROM.get(i*sizeof(ina),ina);                                          // Read EEPROM values               //
-      configRegister = readWord(INA_CONFIGURATION_REGISTER,ina.address);      // Get the current register         //
-      configRegister &= ~INA_CONFIG_MODE_MASK;                                // zero out the mode bits           //
-      ina.operatingMode = B00001111 & mode;                                   // Mask off unused bits             //
-      EEPROM.put((deviceNumber%_DeviceCount)*sizeof(ina),ina);                // Write new EEPROM values          //
-      configRegister |= ina.operatingMode;                                    // shift in the mode settings       //
-      writeWord(INA_CONFIGURATION_REGISTER,configRegister,ina.address);       // Save new value                   //
+      inaDet &ina = _Device[i];                                               // Reference device details in RAM  //
+      ina.configuration &= ~INA_CONFIG_MODE_MASK;                             // zero out the mode bits           //
+      ina.configuration |= mode & INA_CONFIG_MODE_MASK;                       // Mask off unused bits and shift in//
+      writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);            // Save new value                   //
     } // of if this device needs to be set                                    //                                  //
   } // for-next each device loop                                              //                                  //
 } // of method setMode()                                                      //                                  //
 /*******************************************************************************************************************
+** Method triggerAll starts a new conversion on every device by writing the shadow copy of its configuration      **
+** register, one device straight after the other and without reading anything first, so that the devices convert  **
+** at as nearly the same time as the bus allows and their readings can be compared. In triggered mode this starts **
+** a single conversion and in continuous mode it restarts the conversion cycle, devices which are powered down    **
+** are left alone. The INA226 only answers the I2C general call with a reset, so each device has to be written    **
+** individually, taking 3 bytes or about 80us per device at 400KHz. Returns the number of devices triggered       **
+*******************************************************************************************************************/
+uint8_t INA226_Class::triggerAll() {                                          // Start conversions on all devices //
+  uint8_t triggered = 0;                                                      // Number of devices started        //
+  for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
+    inaDet &ina = _Device[i];                                                 // Reference device details in RAM  //
+    if ((ina.configuration&INA_MODE_TRIGGERED_BOTH)==0) continue;             // Skip if powered down             //
+    writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);              // Rewrite to start a conversion    //
+    if (ina.status==INA_STATUS_OK) triggered++;                               // Count it if the write worked     //
+  } // for-next each device loop                                              //                                  //
+  return triggered;                                                           // Return number of devices started //
+} // of method triggerAll()                                                   //                                  //
+/*******************************************************************************************************************
+** Method averagingIndex converts a number of averages into the 3 bit value used in the configuration register,   **
+** rounding down to the nearest setting supported by the INA226                                                   **
+*******************************************************************************************************************/
+uint8_t INA226_Class::averagingIndex(const uint16_t averages) {               // Convert averages to register bits//
+  if      (averages>=1024) return 7;                                          // setting depending upon range     //
+  else if (averages>= 512) return 6;                                          //                                  //
+  else if (averages>= 256) return 5;                                          //                                  //
+  else if (averages>= 128) return 4;                                          //                                  //
+  else if (averages>=  64) return 3;                                          //                                  //
+  else if (averages>=  16) return 2;                                          //                                  //
+  else if (averages>=   4) return 1;                                          //                                  //
+  return 0;                                                                   //                                  //
+} // of method averagingIndex()                                               //                                  //
+/*******************************************************************************************************************
 ** Method setAveraging sets the hardware averaging for the different devices                                      **
 *******************************************************************************************************************/
 void INA226_Class::setAveraging(const uint16_t averages,                      // Set the number of averages taken //
                                 const uint8_t deviceNumber ) {                //                                  //
-  uint8_t averageIndex;                                                       // Store indexed value for register //
-  int16_t configRegister;                                                     // Configuration register contents  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
+  uint8_t averageIndex = averagingIndex(averages);                            // Store indexed value for register //
   for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
     if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
-      configRegister = readWord(INA_CONFIGURATION_REGISTER,ina.address);      // Get the current register         //
-      if      (averages>=1024) averageIndex = 7;                              // setting depending upon range     //
-      else if (averages>= 512) averageIndex = 6;                              //                                  //
-      else if (averages>= 256) averageIndex = 5;                              //                                  //
-      else if (averages>= 128) averageIndex = 4;                              //                                  //
-      else if (averages>=  64) averageIndex = 3;                              //                                  //
-      else if (averages>=  16) averageIndex = 2;                              //                                  //
-      else if (averages>=   4) averageIndex = 1;                              //                                  //
-      else                     averageIndex = 0;                              //                                  //
-      configRegister &= ~INA_CONFIG_AVG_MASK;                                 // zero out the averages part       //
-      configRegister |= (uint16_t)averageIndex << 9;                          // shift in the averages to register//
-      writeWord(INA_CONFIGURATION_REGISTER,configRegister,ina.address);       // Save new value                   //
+      inaDet &ina = _Device[i];                                               // Reference device details in RAM  //
+      ina.configuration &= ~INA_CONFIG_AVG_MASK;                              // zero out the averages part       //
+      ina.configuration |= (uint16_t)averageIndex << 9;                       // shift in the averages to register//
+      writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);            // Save new value                   //
     } // of if this device needs to be set                                    //                                  //
   } // for-next each device loop                                              //                                  //
 } // of method setAveraging()                                                 //                                  //
@@ -244,16 +753,13 @@ void INA226_Class::setAveraging(const uint16_t averages,                      //
 *******************************************************************************************************************/
 void INA226_Class::setBusConversion(uint8_t convTime,                         // Set timing for Bus conversions   //
                                     const uint8_t deviceNumber ) {            //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
-  int16_t configRegister;                                                     // Store configuration register     //
   for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
     if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
+      inaDet &ina = _Device[i];                                               // Reference device details in RAM  //
       if (convTime>7) convTime=7;                                             // Use maximum value allowed        //
-      configRegister = readWord(INA_CONFIGURATION_REGISTER,ina.address);      // Get the current register         //
-      configRegister &= ~INA_CONFIG_BUS_TIME_MASK;                            // zero out the Bus conversion part //
-      configRegister |= (uint16_t)convTime << 6;                              // shift in the averages to register//
-      writeWord(INA_CONFIGURATION_REGISTER,configRegister,ina.address);       // Save new value                   //
+      ina.configuration &= ~INA_CONFIG_BUS_TIME_MASK;                         // zero out the Bus conversion part //
+      ina.configuration |= (uint16_t)convTime << 6;                           // shift in the averages to register//
+      writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);            // Save new value                   //
     } // of if this device needs to be set                                    //                                  //
   } // for-next each device loop                                              //                                  //
 } // of method setBusConversion()                                             //                                  //
@@ -262,51 +768,426 @@ void INA226_Class::setBusConversion(uint8_t convTime,                         //
 *******************************************************************************************************************/
 void INA226_Class::setShuntConversion(uint8_t convTime,                       // Set timing for Bus conversions   //
                                       const uint8_t deviceNumber ) {          //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
-  int16_t configRegister;                                                     // Store configuration register     //
   for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
     if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
+      inaDet &ina = _Device[i];                                               // Reference device details in RAM  //
       if (convTime>7) convTime=7;                                             // Use maximum value allowed        //
-      configRegister = readWord(INA_CONFIGURATION_REGISTER,ina.address);      // Get the current register         //
-      configRegister &= ~INA_CONFIG_SHUNT_TIME_MASK;                          // zero out the Bus conversion part //
-      configRegister |= (uint16_t)convTime << 3;                              // shift in the averages to register//
-      writeWord(INA_CONFIGURATION_REGISTER,configRegister,ina.address);       // Save new value                   //
+      ina.configuration &= ~INA_CONFIG_SHUNT_TIME_MASK;                       // zero out the Bus conversion part //
+      ina.configuration |= (uint16_t)convTime << 3;                           // shift in the averages to register//
+      writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);            // Save new value                   //
     } // of if this device needs to be set                                    //                                  //
   } // for-next each device loop                                              //                                  //
 } // of method setShuntConversion()                                           //                                  //
 /*******************************************************************************************************************
+** Method configure sets the averaging, the bus and shunt conversion times and the operating mode together. The   **
+** complete configuration register is composed once and written with a single I2C transaction per device rather   **
+** than the separate setAveraging(), setBusConversion(), setShuntConversion() and setMode() calls                 **
+*******************************************************************************************************************/
+void INA226_Class::configure(const uint16_t averages, uint8_t busConvTime,    // Set averaging, conversion times  //
+                             uint8_t shuntConvTime, const uint8_t mode,       // and mode in one register write   //
+                             const uint8_t deviceNumber ) {                   //                                  //
+  if (busConvTime>7)   busConvTime=7;                                         // Use maximum value allowed        //
+  if (shuntConvTime>7) shuntConvTime=7;                                       // Use maximum value allowed        //
+  uint16_t configBits = (uint16_t)averagingIndex(averages) << 9 |             // Compose all of the settings into //
+                        (uint16_t)busConvTime << 6 |                          // the register bits                //
+                        (uint16_t)shuntConvTime << 3 |                        //                                  //
+                        (mode & INA_CONFIG_MODE_MASK);                        //                                  //
+  for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
+    if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
+      inaDet &ina = _Device[i];                                               // Reference device details in RAM  //
+      ina.configuration &= ~(INA_CONFIG_AVG_MASK|INA_CONFIG_BUS_TIME_MASK|    // zero out all of the settings     //
+                             INA_CONFIG_SHUNT_TIME_MASK|INA_CONFIG_MODE_MASK);//                                  //
+      ina.configuration |= configBits;                                        // shift in the new settings        //
+      writeWord(INA_CONFIGURATION_REGISTER,ina.configuration,ina);            // Save new value                   //
+    } // of if this device needs to be set                                    //                                  //
+  } // for-next each device loop                                              //                                  //
+} // of method configure()                                                    //                                  //
+/*******************************************************************************************************************
 ** Method waitForConversion loops until the current conversion is marked as finished. If the conversion has       **
-** completed already then the flag (and interrupt pin, if activated) is also reset.                               **
+** completed already then the flag (and interrupt pin, if activated) is also reset. When setAlertInterrupt() has  **
+** been called the loop waits on the interrupt flag rather than continually polling the device over I2C. A device **
+** which is powered down isn't converting and is skipped straight away. The wait is bounded by the timeout set in **
+** setConversionTimeout(), or by default twice the conversion time of the device plus 10ms. Returns false if a    **
+** device timed out or could not be read, getLastError() gives the cause                                          **
 *******************************************************************************************************************/
-void INA226_Class::waitForConversion(const uint8_t deviceNumber) {            // Wait for current conversion      //
-  uint16_t conversionBits = 0;                                                //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
+bool INA226_Class::waitForConversion(const uint8_t deviceNumber) {            // Wait for current conversion      //
   for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
     if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
-      conversionBits = 0;                                                     //                                  //
-      while(conversionBits==0) {                                              //                                  //
-        conversionBits = readWord(INA_MASK_ENABLE_REGISTER,ina.address)       //                                  //
-                         &(uint16_t)8;                                        //                                  //
+      if (getConversionMicros(i)==0) continue;                                // Powered down, nothing to wait for//
+      uint32_t timeout = UINT32_MAX;                                          // Saturate timeout in microseconds //
+      if (_ConversionTimeout<=UINT32_MAX/1000)                                // if milliseconds would overflow   //
+        timeout = _ConversionTimeout*1000;                                    // Timeout in microseconds          //
+      if (_ConversionTimeout==0)                                              // Compute the timeout from the     //
+        timeout = 2*getConversionMicros(i)+10000;                             // configured conversion time       //
+      uint32_t startMicros = micros();                                        // Start time of the wait           //
+      uint32_t spins       = 0;                                               // Number of polls while waiting    //
+      _Device[i].status    = INA_STATUS_OK;                                   // Reset status of earlier calls    //
+      while(!conversionReady(i)) {                                            // Loop until conversion has ended  //
+        spins++;                                                              // Count the poll                   //
+        if (_Device[i].status) break;                                         // Stop if the device can't be read //
+        if (micros()-startMicros>timeout) {                                   // Stop if the wait is too long     //
+          _LastError        = INA_STATUS_TIMEOUT;                             // and flag the timeout             //
+          _Device[i].status = INA_STATUS_TIMEOUT;                             //                                  //
+          #if INA_LOG_LEVEL>=INA_LOG_ERROR                                    //                                  //
+            logValue(_Device[i],F("Conversion timeout us = "),timeout);       // Log the timeout                  //
+          #endif                                                              //                                  //
+          break;                                                              //                                  //
+        } // of if-then timeout                                               //                                  //
       } // of while the conversion hasn't finished                            //                                  //
+      countWait(_Device[i],spins,micros()-startMicros);                       // Count for the statistics         //
+      if (_Device[i].status) return false;                                    // Return if read failed or timeout //
     } // of if this device needs to be set                                    //                                  //
   } // for-next each device loop                                              //                                  //
+  return true;                                                                // All conversions finished         //
 } // of method waitForConversion()                                            //                                  //
 /*******************************************************************************************************************
+** Method setConversionTimeout sets the maximum time in milliseconds that waitForConversion() will wait for each  **
+** device. A value of 0 computes the timeout automatically from the device configuration. Values above            **
+** UINT32_MAX/1000 are limited to UINT32_MAX microseconds, about 71 minutes                                       **
+*******************************************************************************************************************/
+void INA226_Class::setConversionTimeout(const uint32_t milliSeconds) {        // Set waitForConversion() timeout  //
+  _ConversionTimeout = milliSeconds;                                          // Store the new value              //
+} // of method setConversionTimeout()                                         //                                  //
+/*******************************************************************************************************************
+** Method getConversionMicros returns the time in microseconds that one complete, averaged, measurement takes     **
+** using the conversion times, averaging and mode from the shadow configuration register. Power-down mode gives 0 **
+*******************************************************************************************************************/
+uint32_t INA226_Class::getConversionMicros(const uint8_t deviceNumber) {      // Return the conversion period     //
+  return conversionMicros(device(deviceNumber).configuration);                // Use the shadow copy              //
+} // of method getConversionMicros()                                          //                                  //
+/*******************************************************************************************************************
+** Method conversionMicros computes the measurement time for a configuration register value. It is static so that **
+** the simulated device in INA226_Sim.h uses the same timing                                                      **
+*******************************************************************************************************************/
+uint32_t INA226_Class::conversionMicros(const uint16_t configuration) {       // Conversion period of a setting   //
+  const uint16_t conversionTimes[8] = {140,204,332,588,1100,2116,4156,8244};  // Conversion time in microseconds  //
+  const uint16_t averages[8]        = {1,4,16,64,128,256,512,1024};           // Number of averages               //
+  if ((configuration&INA_MODE_TRIGGERED_BOTH)==0) return 0;                   // Power-down mode                  //
+  uint32_t period = 0;                                                        // Time for a single conversion     //
+  if (bitRead(configuration,0))                                               // Add shunt time if shunt measured //
+    period += conversionTimes[(configuration&INA_CONFIG_SHUNT_TIME_MASK)>>3]; //                                  //
+  if (bitRead(configuration,1))                                               // Add bus time if bus measured     //
+    period += conversionTimes[(configuration&INA_CONFIG_BUS_TIME_MASK)>>6];   //                                  //
+  return period*averages[(configuration&INA_CONFIG_AVG_MASK)>>9];             // Multiply by the averages         //
+} // of method conversionMicros()                                             //                                  //
+/*******************************************************************************************************************
+** Method getLastError returns the last error found since the previous call, 0 if there have been none. Values of **
+** 1 to 5 are the Wire library endTransmission() codes, INA_STATUS_READ_ERROR means fewer bytes were returned than**
+** requested and INA_STATUS_TIMEOUT that waitForConversion() timed out. The error is then reset                   **
+*******************************************************************************************************************/
+uint8_t INA226_Class::getLastError() {                                        // Return and reset the last error  //
+  uint8_t lastError = _LastError;                                             // Store the error                  //
+  _LastError = INA_STATUS_OK;                                                 // Reset it                         //
+  return lastError;                                                           // Return the stored value          //
+} // of method getLastError()                                                 //                                  //
+/*******************************************************************************************************************
+** Method getStatus returns the result of the most recent I2C transaction with a device, INA_STATUS_OK if it      **
+** succeeded. Unlike getLastError() the value is kept separately for each device and isn't reset when read, so    **
+** tasks reading different devices at the same time each see the result of their own calls                        **
+*******************************************************************************************************************/
+uint8_t INA226_Class::getStatus(const uint8_t deviceNumber) {                 // Return status of last I2C call   //
+  return device(deviceNumber).status;                                         // Status kept with the device      //
+} // of method getStatus()                                                    //                                  //
+#ifdef INA_ENABLE_STATS                                                       // Only with statistics enabled     //
+  /*****************************************************************************************************************
+  ** Method getStats copies the statistics of a device into "stats" and resetStats sets them back to 0 for one    **
+  ** device or, by default, all of them. The statistics are only kept when INA_ENABLE_STATS is defined by build   **
+  ** flags, as defining it in the sketch doesn't affect the compilation of the library                            **
+  *****************************************************************************************************************/
+  void INA226_Class::getStats(inaStats &stats,                                // Copy statistics of a device      //
+                              const uint8_t deviceNumber) {                   //                                  //
+    noInterrupts();                                                           // Copy isn't atomic, and a transfer//
+    stats = _Stats[&device(deviceNumber)-_Device];                            // may complete in an interrupt     //
+    interrupts();                                                             //                                  //
+  } // of method getStats()                                                   //                                  //
+  void INA226_Class::resetStats(const uint8_t deviceNumber) {                 // Reset statistics to 0            //
+    for(uint8_t i=0;i<INA_MAX_DEVICES;i++) {                                  // Loop for each table entry        //
+      if(deviceNumber==UINT8_MAX || &device(deviceNumber)==&_Device[i]) {     // If this device needs resetting   //
+        noInterrupts();                                                       // Not atomic, see getStats()       //
+        memset(&_Stats[i],0,sizeof(inaStats));                                // Clear the statistics             //
+        interrupts();                                                         //                                  //
+      } // of if this device needs to be reset                                //                                  //
+    } // for-next each device                                                 //                                  //
+  } // of method resetStats()                                                 //                                  //
+#endif                                                                        //                                  //
+#if INA_LOG_LEVEL>INA_LOG_NONE                                                // Only with logging enabled        //
+  /*****************************************************************************************************************
+  ** Method setLogOutput sets where log messages are written, for example "INA226.setLogOutput(Serial);".         **
+  ** Messages are only compiled in when INA_LOG_LEVEL is set by build flags to INA_LOG_ERROR (failed transfers    **
+  ** and conversion timeouts), INA_LOG_INFO (also the calibration computed by begin()) or INA_LOG_DEBUG (also the **
+  ** raw registers read). The default INA_LOG_NONE removes all logging code and text, so the library never writes **
+  ** to a serial port unless asked to. Messages have the form "INA226 0x40 text value" and text is kept in flash  **
+  ** memory on AVR processors                                                                                     **
+  *****************************************************************************************************************/
+  void INA226_Class::setLogOutput(Print &output) {                            // Set where log messages are sent  //
+    _LogOutput = &output;                                                     // Store the destination            //
+  } // of method setLogOutput()                                               //                                  //
+  void INA226_Class::logValue(const inaDet &ina,                              // Write a log message for a device //
+                              const __FlashStringHelper *text,                //                                  //
+                              const int32_t value) {                          //                                  //
+    if (_LogOutput==NULL) return;                                             // Nothing to do if not set         //
+    _LogOutput->print(F("INA226 0x"));                                        // Identify the device by address   //
+    _LogOutput->print(ina.address,HEX);                                       //                                  //
+    _LogOutput->print(' ');                                                   //                                  //
+    _LogOutput->print(text);                                                  // followed by the message text     //
+    _LogOutput->println(value);                                               // and the value                    //
+  } // of method logValue()                                                   //                                  //
+#endif                                                                        //                                  //
+/*******************************************************************************************************************
+** Method setBusLock sets a function which is called with "lock" set to true before each I2C transaction and with **
+** "lock" false after it, receiving the bus the transaction uses. It typically takes and gives back a mutex       **
+** belonging to that bus, so that other tasks and libraries sharing the bus can't interleave their own transfers  **
+** with the write and read of a register, while buses with separate mutexes still run in parallel. The handler    **
+** must not access this library. With a transport that transfers in the background the bus locked by              **
+** startRawSample() is released from the completion interrupt, so the handler has to be callable from there.      **
+** NULL, the default, disables locking for single threaded programs                                               **
+*******************************************************************************************************************/
+void INA226_Class::setBusLock(void (*lockHandler)(TwoWire &bus,               // Set the bus lock handler         //
+                                                  const bool lock)) {         //                                  //
+  _BusLock = lockHandler;                                                     // Store the handler, NULL for none //
+} // of method setBusLock()                                                   //                                  //
+/*******************************************************************************************************************
+** Method conversionReady returns immediately, true if the device has finished a conversion since the last call   **
+** and false otherwise. Reading the mask/enable register resets the flag and releases the alert pin. When the     **
+** alert interrupt is used the I2C read is skipped until the alert pin has triggered; the shared flag is cleared  **
+** once the pin is released, so several devices can share one wired-OR alert line. Not to be called from an ISR   **
+*******************************************************************************************************************/
+bool INA226_Class::conversionReady(const uint8_t deviceNumber) {              // Non-blocking conversion check    //
+  if (_AlertPin!=UINT8_MAX && !_AlertFlag) return false;                      // Nothing to do until alert fires  //
+  inaDet &ina = device(deviceNumber);                                         // Reference device details in RAM  //
+  bool ready = readWord(INA_MASK_ENABLE_REGISTER,ina)&INA_CONVERSION_READY_MASK;// Reading also clears the flag   //
+  if (ina.status) ready = false;                                              // Not ready if the read failed     //
+  if (_AlertPin!=UINT8_MAX) {                                                 // If the alert interrupt is used   //
+    noInterrupts();                                                           // Don't lose an alert between the  //
+    if (digitalRead(_AlertPin)==HIGH) _AlertFlag = false;                     // check and resetting the flag     //
+    interrupts();                                                             // once all devices released line   //
+  } // of if-then alert interrupt used                                        //                                  //
+  return ready;                                                               // return conversion state          //
+} // of method conversionReady()                                              //                                  //
+/*******************************************************************************************************************
+** Method setAlertInterrupt sets up the interrupt for the Arduino pin connected to the INA226 ALERT pin, so that  **
+** sketches no longer need to program the interrupt registers themselves. Pins with an external interrupt use     **
+** attachInterrupt(). On Atmel processors pins which only support pin-change interrupts are enabled in the PCMSK  **
+** and PCICR registers, but since the PCINT vectors may be used by other libraries the sketch has to forward the  **
+** vector with "ISR(PCINT0_vect) {INA226_Class::alertHandler();}". The optional userHandler is called from the    **
+** interrupt each time the alert pin goes low. Use setAlertPinOnConversion() to make the INA226 drive the pin.    **
+** If the pin is already low when the interrupt is set up the alert counts as triggered straight away. Returns    **
+** false if the pin cannot generate an interrupt                                                                  **
+*******************************************************************************************************************/
+bool INA226_Class::setAlertInterrupt(const uint8_t alertPin,                  // Let the library handle the alert //
+                                     void (*userHandler)(void)) {             // pin interrupt                    //
+  _AlertUserHandler = userHandler;                                            // Store the optional user handler  //
+  _AlertFlag        = false;                                                  // No alert seen yet                //
+  pinMode(alertPin,INPUT_PULLUP);                                             // ALERT is open-drain, use pullup  //
+  if (digitalPinToInterrupt(alertPin)!=NOT_AN_INTERRUPT) {                    // If an external interrupt pin     //
+    _AlertPin = alertPin;                                                     // Store the pin number             //
+    attachInterrupt(digitalPinToInterrupt(alertPin),alertHandler,FALLING);    // Call handler when pin goes low   //
+    if (!_AlertFlag && digitalRead(alertPin)==LOW) {                          // A pin that is already low gives  //
+      _AlertMicros = micros();                                                // no falling edge, so take its     //
+      _AlertFlag   = true;                                                    // current state as an alert        //
+    } // of if-then pin already active                                        //                                  //
+    return true;                                                              // Return success                   //
+  } // of if-then external interrupt available                                //                                  //
+  #if defined(__AVR__) && defined(PCICR)                                      // Atmel pin-change interrupts      //
+    if (digitalPinToPCICR(alertPin)) {                                        // If pin-change interrupt pin      //
+      _AlertPin = alertPin;                                                   // Store the pin number             //
+      *digitalPinToPCMSK(alertPin) |= bit(digitalPinToPCMSKbit(alertPin));    // Enable PCMSK pin                 //
+      PCIFR |= bit(digitalPinToPCICRbit(alertPin));                           // clear any outstanding interrupt  //
+      PCICR |= bit(digitalPinToPCICRbit(alertPin));                           // enable interrupt for the group   //
+      if (!_AlertFlag && digitalRead(alertPin)==LOW) {                        // A pin that is already low gives  //
+        _AlertMicros = micros();                                              // no falling edge, so take its     //
+        _AlertFlag   = true;                                                  // current state as an alert        //
+      } // of if-then pin already active                                      //                                  //
+      return true;                                                            // Return success                   //
+    } // of if-then pin-change interrupt available                            //                                  //
+  #endif                                                                      // end of conditional compile code  //
+  return false;                                                               // Pin has no interrupt capability  //
+} // of method setAlertInterrupt()                                            //                                  //
+/*******************************************************************************************************************
+** Method alertHandler is the interrupt handler for the alert pin. It only sets a flag (and calls the optional    **
+** user handler) and does no I2C work, so it is safe to call from within an ISR. A pin-change interrupt fires on  **
+** both edges, so only the falling edge is acted upon                                                             **
+*******************************************************************************************************************/
+void INA226_Class::alertHandler() {                                           // Alert pin interrupt handler      //
+  if (_AlertPin==UINT8_MAX || digitalRead(_AlertPin)!=LOW) return;            // Ignore rising edges              //
+  if (!_AlertFlag) _AlertMicros = micros();                                   // Time of first unserviced alert   //
+  _AlertFlag = true;                                                          // Mark that the alert has fired    //
+  if (_AlertUserHandler) _AlertUserHandler();                                 // Call user handler if defined     //
+} // of method alertHandler()                                                 //                                  //
+/*******************************************************************************************************************
 ** Method setAlertPinOnConversion configure the INA226 to pull the ALERT pin low when a conversion is complete    **
 *******************************************************************************************************************/
 void INA226_Class::setAlertPinOnConversion(const bool alertState,             // Enable pin change on conversion  //
                                            const uint8_t deviceNumber ) {     //                                  //
-  inaDet ina;                                                                 // Hold device details in structure //
-  EEPROM.get((deviceNumber%_DeviceCount)*sizeof(ina),ina);                    // Read EEPROM values               //
-  uint16_t alertRegister;                                                     // Hold the alert register          //
+  writeMaskEnable(INA_ALERT_CONVERSION_MASK,                                  // Set or clear the alert bit       //
+                  alertState ? INA_ALERT_CONVERSION_MASK : 0,deviceNumber);   //                                  //
+} // of method setAlertPinOnConversion                                        //                                  //
+/*******************************************************************************************************************
+** Method setAlertLimit programs the alert limit register and selects which measurement the INA226 compares with  **
+** it, making the alert pin fire when the limit is exceeded without the program having to read the device.        **
+** "alertType" is one of the INA_ALERT_* constants and "limit" is in uV for the shunt voltage, mV for the bus     **
+** voltage, uW for the power and uA for the current. The current limits are converted to the equivalent shunt     **
+** voltage using the calibration set by begin() and the offset set by setTrim(), so begin() has to be called      **
+** first. The INA226 monitors one limit at a time, a new call replaces the limit set before and INA_ALERT_OFF     **
+** disables it. Limits outside the range of the register are clipped                                              **
+*******************************************************************************************************************/
+void INA226_Class::setAlertLimit(const uint8_t alertType,                     // Set the alert limit function and //
+                                 const int32_t limit,                         // value in engineering units       //
+                                 const uint8_t deviceNumber) {                //                                  //
+  const uint16_t functions[8] = {0,0x8000,0x4000,0x2000,0x1000,0x0800,        // Mask/enable bits of each alert   //
+                                 0x8000,0x4000};                              // type, current uses shunt limits  //
+  uint8_t type = alertType<8 ? alertType : INA_ALERT_OFF;                     // Disable unknown alert types      //
   for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
     if(deviceNumber==UINT8_MAX || deviceNumber%_DeviceCount==i ) {            // If this device needs setting     //
-      alertRegister = readWord(INA_MASK_ENABLE_REGISTER,ina.address);         // Get the current register         //
-      if (!alertState) alertRegister &= ~((uint16_t)1<<10);                   // zero out the alert bit           //
-                  else alertRegister |= (uint16_t)(1<<10);                    // turn on the alert bit            //
-      writeWord(INA_MASK_ENABLE_REGISTER,alertRegister,ina.address);          // Write register back to device    //
+      inaDet &ina = _Device[i];                                               // Reference device details in RAM  //
+      int64_t raw = 0;                                                        // Limit in register units          //
+      switch (type) {                                                         // Convert from the engineering     //
+        case INA_ALERT_SHUNT_OVER:                                            // units                            //
+        case INA_ALERT_SHUNT_UNDER:                                           //                                  //
+          raw = constrain((int64_t)limit*10/INA_SHUNT_VOLTAGE_LSB,            // Shunt voltage is signed          //
+                          INT16_MIN,INT16_MAX);                               //                                  //
+          break;                                                              //                                  //
+        case INA_ALERT_BUS_OVER:                                              //                                  //
+        case INA_ALERT_BUS_UNDER:                                             //                                  //
+          raw = constrain((int64_t)limit*100/INA_BUS_VOLTAGE_LSB,0,INT16_MAX);// Bus voltage is positive          //
+          break;                                                              //                                  //
+        case INA_ALERT_POWER_OVER:                                            //                                  //
+          if (ina.power_LSB)                                                  // Power is unsigned                //
+            raw = constrain((int64_t)limit*INA_POWER_DIVISOR/ina.power_LSB,   //                                  //
+                            0,UINT16_MAX);                                    //                                  //
+          break;                                                              //                                  //
+        case INA_ALERT_CURRENT_OVER:                                          //                                  //
+        case INA_ALERT_CURRENT_UNDER:                                         //                                  //
+          if (ina.current_LSB && ina.calibration) {                           // If the device is calibrated      //
+            int64_t current = (int64_t)limit*INA_CURRENT_DIVISOR+             // Add the setTrim() offset removed //
+                              (int64_t)ina.currentOffset*ina.current_LSB;     // from the current register reading//
+            raw = constrain(current*2048/                                     // Shunt = current * 2048 / CAL     //
+                            ((int64_t)ina.current_LSB*ina.calibration),       //                                  //
+                            INT16_MIN,INT16_MAX);                             //                                  //
+          } // of if-then calibrated                                          //                                  //
+          break;                                                              //                                  //
+      } // of switch alert type                                               //                                  //
+      ina.alertLimit = (uint16_t)raw;                                         // Store and write the limit first, //
+      writeWord(INA_ALERT_LIMIT_REGISTER,ina.alertLimit,ina);                 // then select the function         //
+      writeMaskEnable(INA_ALERT_FUNCTION_MASK,functions[type],i);             //                                  //
     } // of if this device needs to be set                                    //                                  //
   } // for-next each device loop                                              //                                  //
-} // of method setAlertPinOnConversion                                        //----------------------------------//
+} // of method setAlertLimit()                                                //                                  //
+/*******************************************************************************************************************
+** Methods setAlertPolarity and setAlertLatch set how the alert pin behaves. By default the pin is active low, as **
+** expected by setAlertInterrupt(), and transparent, being released after the next conversion that is within the  **
+** limit. When latched the pin and flag stay set until getAlertLimitType() reads the flags                        **
+*******************************************************************************************************************/
+void INA226_Class::setAlertPolarity(const bool activeHigh,                    // Set the alert pin polarity       //
+                                    const uint8_t deviceNumber) {             //                                  //
+  writeMaskEnable(INA_ALERT_POLARITY_MASK,                                    // Set or clear the polarity bit    //
+                  activeHigh ? INA_ALERT_POLARITY_MASK : 0,deviceNumber);     //                                  //
+} // of method setAlertPolarity()                                             //                                  //
+void INA226_Class::setAlertLatch(const bool latched,                          // Keep the alert until it is read  //
+                                 const uint8_t deviceNumber) {                //                                  //
+  writeMaskEnable(INA_ALERT_LATCH_MASK,                                       // Set or clear the latch bit       //
+                  latched ? INA_ALERT_LATCH_MASK : 0,deviceNumber);           //                                  //
+} // of method setAlertLatch()                                                //                                  //
+/*******************************************************************************************************************
+** Method getAlertLimitType returns the INA_ALERT_* type of the limit set with setAlertLimit() if it has been     **
+** exceeded, otherwise INA_ALERT_OFF. Current limits are reported as the shunt voltage limit they are implemented **
+** with. Reading the flags releases a latched alert pin and also clears the conversion ready flag, so a           **
+** conversion finishing at the same time is not reported by conversionReady()                                     **
+*******************************************************************************************************************/
+uint8_t INA226_Class::getAlertLimitType(const uint8_t deviceNumber) {         // Return alert limit which fired   //
+  inaDet &ina = device(deviceNumber);                                         // Reference device details in RAM  //
+  uint16_t flags = readWord(INA_MASK_ENABLE_REGISTER,ina);                    // Reading also clears the flags    //
+  if (ina.status || !(flags&INA_ALERT_FLAG_MASK)) return INA_ALERT_OFF;       // Return if no limit was exceeded  //
+  for(uint8_t type=INA_ALERT_SHUNT_OVER;type<=INA_ALERT_POWER_OVER;type++) {  // Find the function selected, the  //
+    if (ina.maskEnable&((uint16_t)0x8000>>(type-1))) return type;             // first one has priority           //
+  } // for-next each alert type                                               //                                  //
+  return INA_ALERT_OFF;                                                       // No function selected             //
+} // of method getAlertLimitType()                                            //                                  //
+/*******************************************************************************************************************
+** Method setI2CSpeed changes the I2C clock speed, the INA226 supports up to 2.94MHz in high-speed mode but most  **
+** Arduino hardware is limited to INA_I2C_FAST_MODE (400KHz) or INA_I2C_FAST_MODE_PLUS (1MHz)                     **
+*******************************************************************************************************************/
+void INA226_Class::setI2CSpeed(const uint32_t i2cSpeed) {                     // Set the I2C bus clock speed      //
+  for(uint8_t bus=0;bus<busCount();bus++)                                     // Loop for each I2C bus            //
+    transport(bus).setClock(i2cSpeed);                                        // Set the I2C clock speed          //
+} // of method setI2CSpeed()                                                  //                                  //
+/*******************************************************************************************************************
+** Method setI2CDelay sets the number of microseconds to wait between writing the register pointer and reading    **
+** the register contents. The INA226 doesn't need a delay, so the default of 0 skips it completely; it can be set **
+** for slow or heavily loaded buses which need time to settle                                                     **
+*******************************************************************************************************************/
+void INA226_Class::setI2CDelay(const uint8_t microSeconds) {                  // Set delay between write and read //
+  _I2CDelay = microSeconds;                                                   // Store the new value              //
+} // of method setI2CDelay()                                                  //                                  //
+/*******************************************************************************************************************
+** Method setStorage replaces the EEPROM used by saveDevices() and loadDevices() with another implementation of   **
+** INA226_Storage, for example a simulated memory or a file                                                       **
+*******************************************************************************************************************/
+void INA226_Class::setStorage(INA226_Storage &storage) {                      // Replace the EEPROM storage       //
+  _Storage = &storage;                                                        // Store the new storage            //
+} // of method setStorage()                                                   //                                  //
+/*******************************************************************************************************************
+** Method storage returns the storage used, the EEPROM unless setStorage() was called                             **
+*******************************************************************************************************************/
+INA226_Storage& INA226_Class::storage() {                                     // Return the storage used          //
+  if (_Storage) return *_Storage;                                             // Storage set by setStorage()      //
+  return _EEPROMStorage;                                                      // or the default one               //
+} // of method storage()                                                      //                                  //
+/*******************************************************************************************************************
+** Method saveDevices writes the number of devices and the RAM copy of the device details to EEPROM starting at   **
+** the address given, or to the storage set with setStorage(). This is the only place the library writes to       **
+** EEPROM, so the caller controls the wear. The register pointer and status of the last access are stored as      **
+** unknown and OK, so saving unchanged settings again writes no bytes, and the storage is committed once at the   **
+** end, which for EEPROM emulated in flash is a single sector write. Returns false without writing anything if    **
+** the table doesn't fit into the storage                                                                         **
+*******************************************************************************************************************/
+bool INA226_Class::saveDevices(const uint16_t eepromAddress) {                // Store device details in EEPROM   //
+  if ((uint32_t)eepromAddress+1+_DeviceCount*sizeof(inaDet)>                  // Return if the table doesn't fit  //
+      storage().length()) return false;                                       //                                  //
+  storage().write(eepromAddress,&_DeviceCount,1);                             // Store the number of devices      //
+  for(uint8_t i=0;i<_DeviceCount;i++) {                                       // Loop for each device found       //
+    inaDet stored;                                                            // Copy without the state of the    //
+    memcpy(&stored,&_Device[i],sizeof(inaDet));                               // last access, which changes with  //
+    stored.pointer = INA_UNKNOWN_POINTER;                                     // every read                       //
+    stored.status  = INA_STATUS_OK;                                           //                                  //
+    storage().write(eepromAddress+1+i*sizeof(inaDet),&stored,                 // Store the device structure       //
+                    sizeof(inaDet));                                          //                                  //
+  } // for-next each device loop                                              //                                  //
+  storage().commit();                                                         // Commit all of it at once         //
+  return true;                                                                // Return table saved               //
+} // of method saveDevices()                                                  //                                  //
+/*******************************************************************************************************************
+** Method loadDevices restores device details previously written by saveDevices(), avoiding the I2C scan done in  **
+** begin(). The calibration, configuration and mask registers of each device are rewritten from the stored copy   **
+** so that the device matches the shadow values. All stored entries are checked before any of them is used, so if **
+** the EEPROM contents are invalid the device table is left unchanged and 0 is returned. Returns the number of    **
+** devices restored                                                                                               **
+*******************************************************************************************************************/
+uint8_t INA226_Class::loadDevices(const uint16_t eepromAddress) {             // Restore device details           //
+  uint8_t deviceCount;                                                        // Number of devices stored         //
+  storage().read(eepromAddress,&deviceCount,1);                               // Get the number of devices        //
+  if (deviceCount>INA_MAX_DEVICES) return 0;                                  // Return if EEPROM contents invalid//
+  for(uint8_t i=0;i<deviceCount;i++) {                                        // Check every entry before using   //
+    inaDet stored;                                                            // any, one at a time to save RAM   //
+    storage().read(eepromAddress+1+i*sizeof(inaDet),&stored,sizeof(inaDet));  // Read the device structure        //
+    if (stored.bus>=busCount() || stored.address>0x7F) return 0;              // Return if the bus wasn't added or//
+                                                                              // the address isn't a 7 bit one    //
+  } // for-next each device stored                                            //                                  //
+  for(uint8_t bus=0;bus<busCount();bus++)                                     // Start the I2C wire subsystems    //
+    transport(bus).begin(INA_I2C_STANDARD_MODE);                              //                                  //
+  for(uint8_t i=0;i<deviceCount;i++) {                                        // Loop for each device stored      //
+    storage().read(eepromAddress+1+i*sizeof(inaDet),&_Device[i],              // Read the device structure        //
+                   sizeof(inaDet));                                           //                                  //
+    _Device[i].pointer = INA_UNKNOWN_POINTER;                                 // Register pointer not yet known   //
+    writeWord(INA_CALIBRATION_REGISTER,_Device[i].calibration,                // Write the calibration value      //
+              _Device[i]);                                                    //                                  //
+    writeWord(INA_CONFIGURATION_REGISTER,_Device[i].configuration,            // Write the configuration          //
+              _Device[i]);                                                    //                                  //
+    writeWord(INA_ALERT_LIMIT_REGISTER,_Device[i].alertLimit,                 // Write the alert limit            //
+              _Device[i]);                                                    //                                  //
+    writeWord(INA_MASK_ENABLE_REGISTER,_Device[i].maskEnable,                 // Write the mask/enable settings   //
+              _Device[i]);                                                    //                                  //
+  } // for-next each device loop                                              //                                  //
+  _DeviceCount = deviceCount;                                                 // Store the number of devices      //
+  return _DeviceCount;                                                        // Return number of devices loaded  //
+} // of method loadDevices()                                                  //----------------------------------//
@@ -33,6 +33,39 @@
 **                                                                                                                **
 ** Vers.  Date       Developer                     Comments                                                       **
 ** ====== ========== ============================= ============================================================== **
+** 1.1.32 2026-10-14 https://github.com/SV-Zanshin Added deviceIndex() for the helper classes' per-device tables  **
+** 1.1.31 2026-10-14 https://github.com/SV-Zanshin INA226_Fixed is started with beginFixed(), its begin() deleted **
+** 1.1.30 2026-10-14 https://github.com/SV-Zanshin Current was 100 times too low, INA_CURRENT_DIVISOR is now 1000 **
+** 1.1.29 2026-10-14 https://github.com/SV-Zanshin Added setTrim() per-device gain and offset correction          **
+** 1.1.28 2026-10-14 https://github.com/SV-Zanshin Added Benchmark and SampleRate example sketches                **
+** 1.1.27 2026-10-14 https://github.com/SV-Zanshin Added INA226_DutyCycle power-down between triggered conversions**
+** 1.1.26 2026-10-14 https://github.com/SV-Zanshin Added INA226_RecordWriter compact binary sample records        **
+** 1.1.25 2026-10-14 https://github.com/SV-Zanshin Added triggerAll() starting all conversions back to back       **
+** 1.1.24 2026-10-14 https://github.com/SV-Zanshin Added INA226_Adaptive idle/active conversion profile switching **
+** 1.1.23 2026-10-14 https://github.com/SV-Zanshin Added setAlertLimit(), setAlertPolarity(), setAlertLatch()     **
+** 1.1.22 2026-10-14 https://github.com/SV-Zanshin Added INA226_Statistics min/max/mean/RMS of readings           **
+** 1.1.21 2026-10-14 https://github.com/SV-Zanshin Added INA226_Energy energy and charge accumulator              **
+** 1.1.20 2026-10-14 https://github.com/SV-Zanshin Replaced debug_Mode Serial output with INA_LOG_LEVEL logging   **
+** 1.1.19 2026-10-14 https://github.com/SV-Zanshin Added INA_ENABLE_STATS statistics, getStats()/resetStats()     **
+** 1.1.18 2026-10-14 https://github.com/SV-Zanshin Added INA226_Storage, simulated INA226 in INA226_Sim.h         **
+** 1.1.17 2026-10-14 https://github.com/SV-Zanshin Added INA226_Transport layer and startRawSample()              **
+** 1.1.16 2026-10-14 https://github.com/SV-Zanshin Added setBusLock() handler and per-device getStatus()          **
+** 1.1.15 2026-10-14 https://github.com/SV-Zanshin Added INA226_MultiBusSampler, one task per I2C bus             **
+** 1.1.14 2026-10-14 https://github.com/SV-Zanshin Scan addresses 0x40-0x4F, added addBus() for more I2C buses    **
+** 1.1.13 2026-10-14 https://github.com/SV-Zanshin Added setDiscovery() address list, optional reset in begin()   **
+** 1.1.12 2026-10-14 https://github.com/SV-Zanshin Fixed-point multiplier and shift replace 64 bit divisions      **
+** 1.1.11 2026-10-14 https://github.com/SV-Zanshin Added INA226_Fixed template with compile-time calibration      **
+** 1.1.10 2026-10-14 https://github.com/SV-Zanshin Added raw register getters and convertSample(s) functions      **
+** 1.1.9  2026-10-14 https://github.com/SV-Zanshin Added getRawSample() and INA226_SampleBuffer ring buffer class **
+** 1.1.8  2026-10-14 https://github.com/SV-Zanshin Added INA226_Sampler class for round-robin multi-device reads  **
+** 1.1.7  2026-10-14 https://github.com/SV-Zanshin Timeout in waitForConversion(), added getLastError()           **
+** 1.1.6  2026-10-14 https://github.com/SV-Zanshin Added conversionReady() and driver owned alert pin interrupts  **
+** 1.1.5  2026-10-14 https://github.com/SV-Zanshin Track the register pointer, skip rewriting it when unchanged   **
+** 1.1.4  2026-10-14 https://github.com/SV-Zanshin Removed fixed I2C read delay, added I2C clock speed to begin() **
+** 1.1.3  2026-10-14 https://github.com/SV-Zanshin Added getAllReadings() to read all 4 registers in one go       **
+** 1.1.2  2026-10-14 https://github.com/SV-Zanshin Added configure() to set averaging, timing and mode in 1 write **
+** 1.1.1  2026-10-14 https://github.com/SV-Zanshin Shadow configuration and mask registers, no read-modify-write  **
+** 1.1.0  2026-10-14 https://github.com/SV-Zanshin Device details kept in RAM, EEPROM only used by saveDevices()  **
 ** 1.0.7  2018-06-08 https://github.com/SV-Zanshin https://github.com/SV-Zanshin/INA226/issues/14. Missing calls  **
 **                                                 EEPROM.Get() for device number caused errors sporadic errors   **
 ** 1.0.6  2018-06-01 https://github.com/SV-Zanshin https://github.com/SV-Zanshin/INA226/issues/12. Add getMode()  **
@@ -52,23 +85,78 @@
 **                                                                                                                **
 *******************************************************************************************************************/
 #include "Arduino.h"                                                          // Arduino data type definitions    //
+#include <Wire.h>                                                             // I2C Library definition           //
+#include "INA226_Transport.h"                                                 // I2C transport layer              //
 #ifndef INA226_Class_h                                                        // Guard code definition            //
-  #define debug_Mode                                                          // Comment out when not needed      //
-  #define INA226__Class_h                                                     // Define the name inside guard code//
+  #define INA226_Class_h                                                      // Define the name inside guard code//
+  #ifndef INA_MAX_DEVICES                                                     // Can be overridden by build flags //
+    #define INA_MAX_DEVICES 16                                                // Maximum number of INA226 devices //
+  #endif                                                                      //                                  //
+  #ifndef INA_MAX_BUSES                                                       // Can be overridden by build flags //
+    #define INA_MAX_BUSES 2                                                   // Maximum number of I2C buses      //
+  #endif                                                                      //                                  //
+  #define INA_LOG_NONE  0                                                     // Log levels for INA_LOG_LEVEL, no //
+  #define INA_LOG_ERROR 1                                                     // output, failed transfers, device //
+  #define INA_LOG_INFO  2                                                     // settings and finally the raw     //
+  #define INA_LOG_DEBUG 3                                                     // register values read             //
+  #ifndef INA_LOG_LEVEL                                                       // Can be overridden by build flags //
+    #define INA_LOG_LEVEL INA_LOG_NONE                                        // No log output by default         //
+  #endif                                                                      //                                  //
   /*****************************************************************************************************************
   ** Declare structures used in the class                                                                         **
   *****************************************************************************************************************/
   typedef struct {                                                            // Structure of values per device   //
     uint8_t  address;                                                         // I2C Address of device            //
+    uint8_t  bus;                                                             // Index of the I2C bus of device   //
     uint16_t calibration;                                                     // Calibration register value       //
+    uint16_t nominalCalibration;                                              // calibration before setTrim()     //
+    int16_t  currentOffset;                                                   // Current trim in register units   //
     uint32_t current_LSB;                                                     // Amperage LSB                     //
     uint32_t power_LSB;                                                       // Wattage LSB                      //
-    uint8_t  operatingMode;                                                   // Default continuous mode operation//
+    uint32_t nominal_LSB;                                                     // current_LSB before setTrim()     //
+    uint32_t currentMultiplier;                                               // current_LSB/1000 as fixed-point  //
+    uint32_t powerMultiplier;                                                 // power_LSB/1000 as fixed-point    //
+    uint8_t  currentShift;                                                    // Binary places of the multipliers //
+    uint8_t  powerShift;                                                      //                                  //
+    uint16_t powerLimit;                                                      // Largest power register in range  //
+    uint16_t configuration;                                                   // Copy of configuration register   //
+    uint16_t maskEnable;                                                      // Copy of mask/enable register     //
+    uint16_t alertLimit;                                                      // Copy of alert limit register     //
+    uint8_t  pointer;                                                         // Last register pointer written    //
+    uint8_t  status;                                                          // Result of the last I2C access    //
   } inaDet; // of structure                                                   //                                  //
+  typedef struct {                                                            // Structure of one set of readings //
+    uint16_t busMilliVolts;                                                   // Bus voltage in mV                //
+    int32_t  shuntMicroVolts;                                                 // Shunt voltage in uV              //
+    int32_t  busMicroAmps;                                                    // Current in uA                    //
+    int32_t  busMicroWatts;                                                   // Power in uW                      //
+  } inaReadings; // of structure                                              //                                  //
+  typedef struct {                                                            // Structure of one raw sample      //
+    uint32_t microSeconds;                                                    // micros() timestamp of the sample //
+    uint8_t  deviceNumber;                                                    // Device the sample was read from  //
+    int16_t  shunt;                                                           // Shunt voltage register           //
+    uint16_t bus;                                                             // Bus voltage register             //
+    uint16_t power;                                                           // Power register                   //
+    int16_t  current;                                                         // Current register                 //
+  } inaRawSample; // of structure                                             //                                  //
+  #ifdef INA_ENABLE_STATS                                                     // Statistics only when enabled by  //
+    typedef struct {                                                          // build flags, one set per device  //
+      uint32_t transactions;                                                  // I2C transactions                 //
+      uint32_t bytes;                                                         // Bytes including address bytes    //
+      uint32_t failures;                                                      // Failed transfers                 //
+      uint32_t waitSpins;                                                     // Polls in waitForConversion()     //
+      uint32_t maxWaitMicros;                                                 // Longest waitForConversion() in us//
+    } inaStats; // of structure                                               //                                  //
+  #endif                                                                      //                                  //
   /*****************************************************************************************************************
   ** Declare constants used in the class                                                                          **
   *****************************************************************************************************************/
-  const uint8_t  I2C_DELAY                    =     10;                       // Microsecond delay on write       //
+  const uint8_t  I2C_DELAY                    =     10;                       // Millisecond delay after reset    //
+  const uint8_t  INA_FIRST_ADDRESS            =   0x40;                       // INA226 strap selectable addresses//
+  const uint8_t  INA_ADDRESS_COUNT            =     16;                       // are 0x40 to 0x4F                 //
+  const uint32_t INA_I2C_STANDARD_MODE        = 100000;                       // Default 100KHz I2C clock         //
+  const uint32_t INA_I2C_FAST_MODE            = 400000;                       // Fast mode 400KHz I2C clock       //
+  const uint32_t INA_I2C_FAST_MODE_PLUS       =1000000;                       // Fast mode plus 1MHz I2C clock    //
   const uint8_t  INA_CONFIGURATION_REGISTER   =      0;                       // Registers common to all INAs     //
   const uint8_t  INA_SHUNT_VOLTAGE_REGISTER   =      1;                       //                                  //
   const uint8_t  INA_BUS_VOLTAGE_REGISTER     =      2;                       //                                  //
@@ -76,15 +164,28 @@
   const uint8_t  INA_CURRENT_REGISTER         =      4;                       //                                  //
   const uint8_t  INA_CALIBRATION_REGISTER     =      5;                       //                                  //
   const uint8_t  INA_MASK_ENABLE_REGISTER     =      6;                       //                                  //
+  const uint8_t  INA_ALERT_LIMIT_REGISTER     =      7;                       //                                  //
   const uint8_t  INA_MANUFACTURER_ID_REGISTER =   0xFE;                       //                                  //
+  const uint8_t  INA_UNKNOWN_POINTER          =   0x80;                       // Register pointer state not known //
+  const uint8_t  INA_STATUS_OK                =      0;                       // No error                         //
+  const uint8_t  INA_STATUS_READ_ERROR        =   0x10;                       // Fewer bytes read than requested  //
+  const uint8_t  INA_STATUS_TIMEOUT           =   0x11;                       // Conversion didn't finish in time //
   const uint16_t INA_RESET_DEVICE             = 0x8000;                       // Write to configuration to reset  //
   const uint16_t INA_DEFAULT_CONFIGURATION    = 0x4127;                       // Default configuration register   //
   const uint16_t INA_BUS_VOLTAGE_LSB          =    125;                       // LSB in uV *100 1.25mV            //
   const uint16_t INA_SHUNT_VOLTAGE_LSB        =     25;                       // LSB in uV *10  2.5uV             //
+  const uint32_t INA_CURRENT_DIVISOR          =   1000;                       // current_LSB nA per uA            //
+  const uint32_t INA_POWER_DIVISOR            =   1000;                       // power_LSB nW per uW              //
   const uint16_t INA_CONFIG_AVG_MASK          = 0x0E00;                       // Bits 9-11                        //
   const uint16_t INA_CONFIG_BUS_TIME_MASK     = 0x01C0;                       // Bits 6-8                         //
   const uint16_t INA_CONFIG_SHUNT_TIME_MASK   = 0x0038;                       // Bits 3-5                         //
-  const uint16_t INA_CONVERSION_READY_MASK    = 0x0080;                       // Bit 4                            //
+  const uint16_t INA_CONVERSION_READY_MASK    = 0x0008;                       // Bit 3                            //
+  const uint16_t INA_ALERT_FUNCTION_MASK      = 0xF800;                       // Bits 11-15 select the alert limit//
+  const uint16_t INA_ALERT_CONVERSION_MASK    = 0x0400;                       // Bit 10, alert on conversion ready//
+  const uint16_t INA_ALERT_FLAG_MASK          = 0x0010;                       // Bit 4, alert limit exceeded      //
+  const uint16_t INA_ALERT_POLARITY_MASK      = 0x0002;                       // Bit 1, alert pin active high     //
+  const uint16_t INA_ALERT_LATCH_MASK         = 0x0001;                       // Bit 0, alert latched until read  //
+  const uint16_t INA_MASK_FLAGS               = 0x001C;                       // Bits 2-4 are read-only flags     //
   const uint16_t INA_CONFIG_MODE_MASK         = 0x0007;                       // Bits 0-3                         //
   const uint8_t  INA_MODE_TRIGGERED_SHUNT     =   B001;                       // Triggered shunt, no bus          //
   const uint8_t  INA_MODE_TRIGGERED_BUS       =   B010;                       // Triggered bus, no shunt          //
@@ -93,6 +194,14 @@
   const uint8_t  INA_MODE_CONTINUOUS_SHUNT    =   B101;                       // Continuous shunt, no bus         //
   const uint8_t  INA_MODE_CONTINUOUS_BUS      =   B110;                       // Continuous bus, no shunt         //
   const uint8_t  INA_MODE_CONTINUOUS_BOTH     =   B111;                       // Both continuous, default value   //
+  const uint8_t  INA_ALERT_OFF                =      0;                       // No alert limit                   //
+  const uint8_t  INA_ALERT_SHUNT_OVER         =      1;                       // Shunt voltage over limit in uV   //
+  const uint8_t  INA_ALERT_SHUNT_UNDER        =      2;                       // Shunt voltage under limit in uV  //
+  const uint8_t  INA_ALERT_BUS_OVER           =      3;                       // Bus voltage over limit in mV     //
+  const uint8_t  INA_ALERT_BUS_UNDER          =      4;                       // Bus voltage under limit in mV    //
+  const uint8_t  INA_ALERT_POWER_OVER         =      5;                       // Power over limit in uW           //
+  const uint8_t  INA_ALERT_CURRENT_OVER       =      6;                       // Current over limit in uA, using  //
+  const uint8_t  INA_ALERT_CURRENT_UNDER      =      7;                       // the shunt voltage limits         //
   /*****************************************************************************************************************
   ** Declare class header                                                                                         **
   *****************************************************************************************************************/
@@ -102,15 +211,49 @@
       ~INA226_Class();                                                        // Class destructor                 //
       uint8_t  begin(const uint8_t  maxBusAmps,                               // Class initializer                //
                      const uint32_t microOhmR,                                //                                  //
-                     const uint8_t  deviceNumber = UINT8_MAX );               //                                  //
+                     const uint8_t  deviceNumber = UINT8_MAX,                 //                                  //
+                     const uint32_t i2cSpeed = INA_I2C_STANDARD_MODE);        //                                  //
       uint16_t getBusMilliVolts(const bool waitSwitch=false,                  // Retrieve Bus voltage in mV       //
                                 const uint8_t deviceNumber=0);                //                                  //
       int16_t  getShuntMicroVolts(const bool waitSwitch=false,                // Retrieve Shunt voltage in uV     //
                                   const uint8_t deviceNumber=0);              //                                  //
       int32_t  getBusMicroAmps(const uint8_t deviceNumber=0);                 // Retrieve micro-amps              //
       int32_t  getBusMicroWatts(const uint8_t deviceNumber=0);                // Retrieve micro-watts             //
+      void     getAllReadings(inaReadings &readings,                          // Retrieve shunt, bus, power and   //
+                              const uint8_t deviceNumber=0);                  // current in one bus transaction   //
+      void     getRawSample(inaRawSample &sample,                             // Retrieve unconverted registers   //
+                            const uint8_t deviceNumber=0);                    // with a timestamp                 //
+      bool     startRawSample(inaRawSample &sample,                           // Start background register read   //
+                              void (*callback)(inaRawSample &sample)=NULL,    //                                  //
+                              const uint8_t deviceNumber=0);                  //                                  //
+      bool     rawSamplePending();                                            // Background read in progress      //
+      int16_t  getRawShunt(const uint8_t deviceNumber=0);                     // Retrieve shunt voltage register  //
+      uint16_t getRawBus(const uint8_t deviceNumber=0);                       // Retrieve bus voltage register    //
+      int16_t  getRawCurrent(const uint8_t deviceNumber=0);                   // Retrieve current register        //
+      uint16_t getRawPower(const uint8_t deviceNumber=0);                     // Retrieve power register          //
+      void     convertSample(const inaRawSample &sample,                      // Convert a raw sample to readings //
+                             inaReadings &readings);                          //                                  //
+      void     convertSamples(const inaRawSample samples[],                   // Convert an array of raw samples  //
+                              inaReadings readings[], const uint8_t count);   //                                  //
+      bool     addBus(TwoWire &bus);                                          // Add an I2C bus to search         //
+      void     setDiscovery(const uint8_t addresses[]=NULL,                   // Set addresses and reset option   //
+                            const uint8_t addressCount=0,                     // used by begin()                  //
+                            const bool    resetDevices=true);                 //                                  //
+      uint8_t  getDeviceCount();                                              // Return number of devices found   //
+      uint8_t  deviceIndex(const uint8_t deviceNumber);                       // Table index of a device number   //
+      uint8_t  getDeviceAddress(const uint8_t deviceNumber=0);                // Return I2C address of a device   //
+      TwoWire& getDeviceBus(const uint8_t deviceNumber=0);                    // Return I2C bus of a device       //
+      uint32_t getCurrentLSB(const uint8_t deviceNumber=0);                   // Return current LSB set by begin()//
+      uint32_t getPowerLSB(const uint8_t deviceNumber=0);                     // Return power LSB set by begin()  //
+      int16_t  getCurrentOffset(const uint8_t deviceNumber=0);                // Return offset set by setTrim()   //
+      void     setTrim(const int32_t gainPPM,                                 // Correct the gain and offset of   //
+                       const int32_t offsetMicroAmps=0,                       // the current measured             //
+                       const uint8_t deviceNumber=UINT8_MAX);                 //                                  //
+      bool     setTransport(INA226_Transport &transport,                      // Replace the transport of a bus   //
+                            TwoWire &bus=Wire);                               //                                  //
       void     reset(const uint8_t deviceNumber=0);                           // Reset the device                 //
       void     setMode(const uint8_t mode,const uint8_t devNumber=UINT8_MAX); // Set the monitoring mode          //
+      uint8_t  triggerAll();                                                  // Start conversions on all devices //
       uint8_t  getMode(const uint8_t devNumber=UINT8_MAX);                    // Get the monitoring mode          //
       void     setAveraging(const uint16_t averages,                          // Set the number of averages taken //
                             const uint8_t deviceNumber=UINT8_MAX);            //                                  //
@@ -118,17 +261,112 @@
                                 const uint8_t deviceNumber=UINT8_MAX);        //                                  //
       void     setShuntConversion(uint8_t convTime,                           // Set timing for Shunt conversions //
                                   const uint8_t deviceNumber=UINT8_MAX);      //                                  //
-      void     waitForConversion(const uint8_t deviceNumber=UINT8_MAX);       // wait for conversion to complete  //
+      void     configure(const uint16_t averages, uint8_t busConvTime,        // Set averaging, conversion times  //
+                         uint8_t shuntConvTime,                               // and mode in one register write   //
+                         const uint8_t mode=INA_MODE_CONTINUOUS_BOTH,         //                                  //
+                         const uint8_t deviceNumber=UINT8_MAX);               //                                  //
+      bool     waitForConversion(const uint8_t deviceNumber=UINT8_MAX);       // wait for conversion to complete  //
+      void     setConversionTimeout(const uint32_t milliSeconds);             // Set waitForConversion() timeout  //
+      uint32_t getConversionMicros(const uint8_t deviceNumber=0);             // Return the conversion period     //
+      static uint32_t conversionMicros(const uint16_t configuration);         // Conversion period of a setting   //
+      uint8_t  getLastError();                                                // Return and reset the last error  //
+      uint8_t  getStatus(const uint8_t deviceNumber=0);                       // Return status of last I2C call   //
+      #ifdef INA_ENABLE_STATS                                                 //                                  //
+        void   getStats(inaStats &stats, const uint8_t deviceNumber=0);       // Copy statistics of a device      //
+        void   resetStats(const uint8_t deviceNumber=UINT8_MAX);              // Reset statistics to 0            //
+      #endif                                                                  //                                  //
+      #if INA_LOG_LEVEL>INA_LOG_NONE                                          // Only when logging is enabled     //
+        void   setLogOutput(Print &output);                                   // Set where log messages are sent  //
+      #endif                                                                  //                                  //
+      void     setBusLock(void (*lockHandler)(TwoWire &bus,                   // Set the bus lock handler         //
+                                          const bool lock));                  //                                  //
+      bool     conversionReady(const uint8_t deviceNumber=0);                 // Non-blocking conversion check    //
+      bool     setAlertInterrupt(const uint8_t alertPin,                      // Let the library handle the alert //
+                                 void (*userHandler)(void)=NULL);             // pin interrupt                    //
+      static void alertHandler();                                             // Alert pin interrupt handler      //
       void     setAlertPinOnConversion(const bool alertState,                 // Enable pin change on conversion  //
                                        const uint8_t deviceNumber=UINT8_MAX); //                                  //
+      void     setAlertLimit(const uint8_t alertType, const int32_t limit,    // Set the alert limit function and //
+                             const uint8_t deviceNumber=UINT8_MAX);           // value in engineering units       //
+      void     setAlertPolarity(const bool activeHigh,                        // Set the alert pin polarity       //
+                                const uint8_t deviceNumber=UINT8_MAX);        //                                  //
+      void     setAlertLatch(const bool latched,                              // Keep the alert until it is read  //
+                             const uint8_t deviceNumber=UINT8_MAX);           //                                  //
+      uint8_t  getAlertLimitType(const uint8_t deviceNumber=0);               // Return alert limit which fired   //
+      void     setI2CSpeed(const uint32_t i2cSpeed);                          // Set the I2C bus clock speed      //
+      void     setI2CDelay(const uint8_t microSeconds);                       // Set delay between write and read //
+      bool     saveDevices(const uint16_t eepromAddress=0);                   // Store device details in EEPROM   //
+      uint8_t  loadDevices(const uint16_t eepromAddress=0);                   // Restore device details           //
+      void     setStorage(INA226_Storage &storage);                           // Replace the EEPROM storage       //
+    protected:                                                                // Methods used by derived classes  //
+      uint8_t  discover(const uint32_t i2cSpeed);                             // Find and reset all devices       //
+      void     setCalibration(const uint16_t calibration,                     // Store and write calibration      //
+                              const uint32_t current_LSB,                     //                                  //
+                              const uint32_t power_LSB,                       //                                  //
+                              const uint8_t deviceNumber);                    //                                  //
     private:                                                                  // Private variables and methods    //
-      uint8_t  readByte(const uint8_t addr, const uint8_t deviceAddress);     // Read a byte from an I2C address  //
-      int16_t  readWord(const uint8_t addr, const uint8_t deviceAddress);     // Read a word from an I2C address  //
+      uint8_t  averagingIndex(const uint16_t averages);                       // Convert averages to register bits//
+      uint8_t  busCount();                                                    // Number of I2C buses in use       //
+      void     writeMaskEnable(const uint16_t mask, const uint16_t value,     // Change bits of the mask/enable   //
+                               const uint8_t deviceNumber);                   // register of one or all devices   //
+      INA226_Transport& transport(const uint8_t bus);                         // Return the transport of a bus    //
+      INA226_Storage&   storage();                                            // Return the storage used          //
+      void     scaleFactors(inaDet &ina);                                     // Precompute conversions of device //
+      void     scaleFactor(const uint32_t lsb, const uint32_t divisor,        // Compute fixed-point multiplier   //
+                           uint32_t &multiplier, uint8_t &shift);             // and shift for lsb/divisor        //
+      int32_t  scaleCurrent(const int16_t raw, const inaDet &ina);            // Convert current register to uA   //
+      int32_t  scalePower(const uint16_t raw, const inaDet &ina);             // Convert power register to uW     //
+      bool     checkStatus(const uint8_t status, inaDet &ina);                // Store I2C result, true if success//
+      void     beginAccess(inaDet &ina);                                      // Claim bus, clear device status   //
+      void     endAccess(inaDet &ina);                                        // Release the bus                  //
+      static void transferDone(void *context, const uint8_t status);          // Background read has completed    //
+      void     countTransfer(const inaDet &ina, const uint8_t transactions,   // Count I2C transactions and bytes //
+                             const uint8_t bytes);                            //                                  //
+      void     countWait(const inaDet &ina, const uint32_t spins,             // Count waitForConversion() polls  //
+                         const uint32_t microSeconds);                        //                                  //
+      #if INA_LOG_LEVEL>INA_LOG_NONE                                          //                                  //
+        void   logValue(const inaDet &ina,                                    // Write a log message for a device //
+                        const __FlashStringHelper *text,                      //                                  //
+                        const int32_t value);                                 //                                  //
+      #endif                                                                  //                                  //
+      void     setPointer(const uint8_t addr, inaDet &ina);                   // Set register pointer if changed  //
+      uint8_t  readByte(const uint8_t addr, inaDet &ina);                     // Read a byte from an I2C address  //
+      int16_t  readWord(const uint8_t addr, inaDet &ina);                     // Read a word from an I2C address  //
+      void     readWords(const uint8_t addr, int16_t *data,                   // Read consecutive registers using //
+                         const uint8_t count, inaDet &ina);                   // repeated starts                  //
       void     writeByte(const uint8_t addr, const uint8_t data,              // Write a byte to an I2C address   //
-                         const uint8_t deviceAddress);                        //                                  //
+                         inaDet &ina);                                        //                                  //
       void     writeWord(const uint8_t addr, const uint16_t data,             // Write two bytes to an I2C address//
-                         const uint8_t deviceAddress);                        //                                  //
-      uint8_t  _TransmissionStatus = 0;                                       // Return code for I2C transmission //
+                         inaDet &ina);                                        //                                  //
+      inaDet&  device(const uint8_t deviceNumber);                            // Return details for a device      //
       uint8_t  _DeviceCount        = 0;                                       // Number of INA226s detected       //
+      uint8_t  _I2CDelay           = 0;                                       // Microseconds between write & read//
+      uint8_t  _LastError          = 0;                                       // Last error since getLastError()  //
+      uint32_t _ConversionTimeout  = 0;                                       // Wait limit in ms, 0 is automatic //
+      const uint8_t *_Addresses    = NULL;                                    // Known addresses, NULL to scan    //
+      uint8_t  _AddressCount       = 0;                                       // Number of known addresses        //
+      bool     _ResetOnBegin       = true;                                    // Reset devices when enumerating   //
+      uint8_t  _BusCount           = 0;                                       // Number of buses added, 0 is Wire //
+      TwoWire *_Bus[INA_MAX_BUSES] = {&Wire};                                 // I2C buses to use                 //
+      void   (*_BusLock)(TwoWire &bus, const bool lock) = NULL;               // Optional bus lock handler        //
+      INA226_Transport    *_Transport[INA_MAX_BUSES] = {};                    // Transports set by setTransport() //
+      INA226_WireTransport _WireTransport[INA_MAX_BUSES];                     // Default transport of each bus    //
+      INA226_Storage      *_Storage = NULL;                                   // Storage set by setStorage()      //
+      INA226_EEPROMStorage _EEPROMStorage;                                    // Default storage                  //
+      #if INA_LOG_LEVEL>INA_LOG_NONE                                          //                                  //
+        Print *_LogOutput = NULL;                                             // Log destination, NULL if none    //
+      #endif                                                                  //                                  //
+      volatile bool _Pending       = false;                                   // Set while startRawSample() runs  //
+      inaRawSample *_PendingSample = NULL;                                    // Sample being read                //
+      void        (*_PendingCallback)(inaRawSample &sample) = NULL;           // Called when the read is done     //
+      uint8_t       _PendingData[8];                                          // Registers received by transport  //
+      static volatile bool _AlertFlag;                                        // Set when alert pin has triggered //
+      static volatile uint32_t _AlertMicros;                                  // micros() when the alert triggered//
+      static uint8_t       _AlertPin;                                         // Alert pin, UINT8_MAX if not used //
+      static void        (*_AlertUserHandler)(void);                          // Optional user interrupt handler  //
+      inaDet   _Device[INA_MAX_DEVICES] = {};                                 // Device details held in RAM       //
+      #ifdef INA_ENABLE_STATS                                                 //                                  //
+        inaStats _Stats[INA_MAX_DEVICES] = {};                                // Statistics of each device        //
+      #endif                                                                  //                                  //
   }; // of INA226_Class definition                                            //                                  //
 #endif                                                                        //----------------------------------//
@@ -0,0 +1,111 @@
+/*******************************************************************************************************************
+** INA226_Adaptive class method definitions for INA226 Library.                                                   **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_Adaptive.h"                                                  // Include the header definition    //
+INA226_Adaptive::INA226_Adaptive(INA226_Class &ina) : _INA(ina) {}            // Class constructor                //
+INA226_Adaptive::~INA226_Adaptive() {}                                        // Unused class destructor          //
+/*******************************************************************************************************************
+** Methods setIdleProfile and setActiveProfile set the averaging and conversion times of the two profiles, using  **
+** the same values as INA226_Class::configure(). They take effect the next time a device switches profile         **
+*******************************************************************************************************************/
+void INA226_Adaptive::setIdleProfile(const uint16_t averages,                 // Profile used while the current   //
+                                     const uint8_t busConvTime,               // is steady                        //
+                                     const uint8_t shuntConvTime) {           //                                  //
+  _Idle.averages      = averages;                                             // Store the settings               //
+  _Idle.busConvTime   = busConvTime;                                          //                                  //
+  _Idle.shuntConvTime = shuntConvTime;                                        //                                  //
+} // of method setIdleProfile()                                               //                                  //
+void INA226_Adaptive::setActiveProfile(const uint16_t averages,               // Profile used while the current   //
+                                       const uint8_t busConvTime,             // is changing                      //
+                                       const uint8_t shuntConvTime) {         //                                  //
+  _Active.averages      = averages;                                           // Store the settings               //
+  _Active.busConvTime   = busConvTime;                                        //                                  //
+  _Active.shuntConvTime = shuntConvTime;                                      //                                  //
+} // of method setActiveProfile()                                             //                                  //
+/*******************************************************************************************************************
+** Method begin() has to be called after INA226_Class::begin(). It converts the threshold from microamps into     **
+** current register units for each device, using its calibration, and puts all devices into the idle profile.     **
+** "holdReadings" is the number of consecutive readings within the threshold after which an active device returns **
+** to the idle profile                                                                                            **
+*******************************************************************************************************************/
+void INA226_Adaptive::begin(const int32_t thresholdMicroAmps,                 // Set thresholds and put all       //
+                            const uint16_t holdReadings) {                    // devices into the idle profile    //
+  _HoldReadings = holdReadings;                                               // Store the hold count             //
+  for(uint8_t i=0;i<_INA.getDeviceCount();i++) {                              // Loop for each device found       //
+    uint32_t lsb = _INA.getCurrentLSB(i);                                     // Current LSB of the device        //
+    int64_t  raw = lsb ? (int64_t)thresholdMicroAmps*INA_CURRENT_DIVISOR/lsb  // Convert to register units        //
+                       : UINT16_MAX;                                          //                                  //
+    _Threshold[i] = constrain(raw,0,UINT16_MAX);                              //                                  //
+    _HasLast[i]   = false;                                                    // No previous reading yet          //
+    select(i,false);                                                          // Start in the idle profile        //
+  } // for-next each device loop                                              //                                  //
+} // of method begin()                                                        //                                  //
+/*******************************************************************************************************************
+** Method poll() reads the device if it has finished a conversion, adapts its profile and converts the registers  **
+** into "readings". It returns true if a reading was taken                                                        **
+*******************************************************************************************************************/
+bool INA226_Adaptive::poll(inaReadings &readings,                             // Read and adapt a device          //
+                           const uint8_t deviceNumber) {                      //                                  //
+  if (!_INA.conversionReady(deviceNumber)) return false;                      // Nothing to do if still converting//
+  inaRawSample sample;                                                        // Unconverted register values      //
+  _INA.getRawSample(sample,deviceNumber);                                     // Read all 4 registers             //
+  update(sample);                                                             // Switch profile if needed         //
+  _INA.convertSample(sample,readings);                                        // and convert the readings         //
+  return true;                                                                // Return reading taken             //
+} // of method poll()                                                         //                                  //
+/*******************************************************************************************************************
+** Method update() compares the current register of a sample with the previous one of the same device and         **
+** switches the profile if needed. Switching writes the configuration register, so unlike                         **
+** INA226_Statistics::add() this cannot be called from the startRawSample() callback                              **
+*******************************************************************************************************************/
+void INA226_Adaptive::update(const inaRawSample &sample) {                    // Adapt to a sample read elsewhere //
+  uint8_t i      = _INA.deviceIndex(sample.deviceNumber);                     // Table index of the device        //
+  int32_t change = (int32_t)sample.current-_Last[i];                          // Change since the previous reading//
+  bool    first  = !_HasLast[i];                                              // Nothing to compare with yet      //
+  _Last[i]       = sample.current;                                            // Keep for the next reading        //
+  _HasLast[i]    = true;                                                      //                                  //
+  if (first) return;                                                          //                                  //
+  if (change>_Threshold[i] || -change>_Threshold[i]) {                        // If the current has changed then  //
+    _Quiet[i] = 0;                                                            // restart the hold count and make  //
+    if (!_IsActive[i]) select(i,true);                                        // sure the active profile is used  //
+  } else if (_IsActive[i] && ++_Quiet[i]>=_HoldReadings) {                    // If quiet for long enough then    //
+    select(i,false);                                                          // return to the idle profile       //
+  } // of if-then-else current changed                                        //                                  //
+} // of method update()                                                       //                                  //
+/*******************************************************************************************************************
+** Method wake() switches one or, by default, all devices to the active profile, the hold count starts again so   **
+** they stay active for at least "holdReadings" readings                                                          **
+*******************************************************************************************************************/
+void INA226_Adaptive::wake(const uint8_t deviceNumber) {                      // Switch to the active profile     //
+  for(uint8_t i=0;i<_INA.getDeviceCount();i++) {                              // Loop for each device found       //
+    if(deviceNumber==UINT8_MAX || _INA.deviceIndex(deviceNumber)==i) {        // If this device needs setting     //
+      _Quiet[i] = 0;                                                          // Restart the hold count           //
+      if (!_IsActive[i]) select(i,true);                                      // Switch if not already active     //
+    } // of if this device needs to be set                                    //                                  //
+  } // for-next each device loop                                              //                                  //
+} // of method wake()                                                         //                                  //
+bool INA226_Adaptive::isActive(const uint8_t deviceNumber) {                  // True if active profile is in use //
+  return _IsActive[_INA.deviceIndex(deviceNumber)];                           // Return stored value              //
+} // of method isActive()                                                     //                                  //
+/*******************************************************************************************************************
+** Method select() writes a profile to a device, keeping its operating mode. In triggered mode the write also     **
+** starts the next conversion                                                                                     **
+*******************************************************************************************************************/
+void INA226_Adaptive::select(const uint8_t i, const bool active) {            // Apply a profile to a device      //
+  const inaProfile &profile = active ? _Active : _Idle;                       // Settings to use                  //
+  _INA.configure(profile.averages,profile.busConvTime,profile.shuntConvTime,  // Write them in one transaction    //
+                 _INA.getMode(i),i);                                          //                                  //
+  _IsActive[i] = active;                                                      // Store the state                  //
+  _Quiet[i]    = 0;                                                           //                                  //
+} // of method select()                                                       //----------------------------------//
@@ -0,0 +1,68 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_Adaptive class, which switches each INA226 device between two           **
+** conversion profiles depending on the activity of its current. While the current is steady a device runs the    **
+** idle profile, by default 128 averages of 1.1ms conversions, so a reading is only produced about every 280ms    **
+** and the bus and processor are hardly used. As soon as the current register of a device changes by more than    **
+** the threshold from one reading to the next the device is switched to the active profile, by default single     **
+** 1.1ms conversions, to resolve the transient. Once the given number of consecutive active readings have stayed  **
+** within the threshold the device falls back to the idle profile. wake() switches devices to the active profile  **
+** directly, e.g. when the alert limit set with INA226_Class::setAlertLimit() has fired.                          **
+**                                                                                                                **
+** Profiles are applied with INA226_Class::configure() in a single register write, keeping the operating mode of  **
+** the device, and the comparison uses raw register values so that no conversion is needed for devices which are  **
+** idle.                                                                                                          **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_Adaptive_h                                                     // Guard code definition            //
+  #define INA226_Adaptive_h                                                   // Define the name inside guard code//
+  /*****************************************************************************************************************
+  ** Declare structures used in the class                                                                         **
+  *****************************************************************************************************************/
+  typedef struct {                                                            // Structure of a conversion profile//
+    uint16_t averages;                                                        // Number of averages, see configure//
+    uint8_t  busConvTime;                                                     // Bus conversion time 0-7          //
+    uint8_t  shuntConvTime;                                                   // Shunt conversion time 0-7        //
+  } inaProfile; // of structure                                               //                                  //
+  /*****************************************************************************************************************
+  ** Declare class header                                                                                         **
+  *****************************************************************************************************************/
+  class INA226_Adaptive {                                                     // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_Adaptive(INA226_Class &ina);                                     // Class constructor                //
+      ~INA226_Adaptive();                                                     // Class destructor                 //
+      void     setIdleProfile(const uint16_t averages,                        // Profile used while the current   //
+                              const uint8_t busConvTime,                      // is steady                        //
+                              const uint8_t shuntConvTime);                   //                                  //
+      void     setActiveProfile(const uint16_t averages,                      // Profile used while the current   //
+                                const uint8_t busConvTime,                    // is changing                      //
+                                const uint8_t shuntConvTime);                 //                                  //
+      void     begin(const int32_t thresholdMicroAmps,                        // Set thresholds and put all       //
+                     const uint16_t holdReadings=16);                         // devices into the idle profile    //
+      bool     poll(inaReadings &readings, const uint8_t deviceNumber=0);     // Read and adapt a device          //
+      void     update(const inaRawSample &sample);                            // Adapt to a sample read elsewhere //
+      void     wake(const uint8_t deviceNumber=UINT8_MAX);                    // Switch to the active profile     //
+      bool     isActive(const uint8_t deviceNumber=0);                        // True if active profile is in use //
+    private:                                                                  // Private variables and methods    //
+      void     select(const uint8_t i, const bool active);                    // Apply a profile to a device      //
+      INA226_Class &_INA;                                                     // Devices being sampled            //
+      inaProfile _Idle   = {128,4,4};                                         // Profile while steady             //
+      inaProfile _Active = {1,4,4};                                           // Profile while changing           //
+      uint16_t _HoldReadings = 16;                                            // Quiet readings before idling     //
+      uint16_t _Threshold[INA_MAX_DEVICES] = {};                              // Change in current register units //
+      int16_t  _Last[INA_MAX_DEVICES]      = {};                              // Previous current register        //
+      uint16_t _Quiet[INA_MAX_DEVICES]     = {};                              // Quiet readings while active      //
+      bool     _IsActive[INA_MAX_DEVICES]  = {};                              // Active profile in use            //
+      bool     _HasLast[INA_MAX_DEVICES]   = {};                              // Previous reading is valid        //
+  }; // of INA226_Adaptive definition                                         //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,108 @@
+/*******************************************************************************************************************
+** INA226_DutyCycle class method definitions for INA226 Library.                                                  **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_DutyCycle.h"                                                 // Include the header definition    //
+INA226_DutyCycle::INA226_DutyCycle(INA226_Class &ina) : _INA(ina) {}          // Class constructor                //
+INA226_DutyCycle::~INA226_DutyCycle() {}                                      // Unused class destructor          //
+/*******************************************************************************************************************
+** Method begin() has to be called after INA226_Class::begin() and the averaging and conversion times have been   **
+** set. It powers down the device, or all devices, and starts the duty cycle with the first conversion triggered  **
+** by the next call to poll(). "mode" selects the measurements, a continuous mode is replaced by the triggered    **
+** mode with the same measurements. Intervals up to 71 minutes can be used, an interval too short for the         **
+** conversions to finish is lengthened by trigger()                                                               **
+*******************************************************************************************************************/
+void INA226_DutyCycle::begin(const uint32_t intervalMillis,                   // Power down devices and start the //
+                             const uint8_t mode,                              // duty cycle                       //
+                             const uint8_t deviceNumber) {                    //                                  //
+  _Mode         = mode&INA_MODE_TRIGGERED_BOTH;                               // Use the triggered equivalent     //
+  if (_Mode==0) _Mode = INA_MODE_TRIGGERED_BOTH;                              // and both if none was selected    //
+  _DeviceNumber = deviceNumber;                                               // Store the settings               //
+  _Requested    = intervalMillis*1000;                                        //                                  //
+  _Interval     = _Requested;                                                 // Lengthened by trigger() if needed//
+  _Remaining    = 0;                                                          // No conversions running yet       //
+  _INA.setMode(INA_MODE_POWER_DOWN,deviceNumber);                             // Power down the devices           //
+  _LastTrigger  = micros()-_Interval;                                         // First conversion is due now      //
+  _Running      = true;                                                       // Duty cycle has started           //
+} // of method begin()                                                        //                                  //
+/*******************************************************************************************************************
+** Method end() stops the duty cycle and leaves the devices powered down until INA226_Class::setMode() is used to **
+** change the mode                                                                                                **
+*******************************************************************************************************************/
+void INA226_DutyCycle::end() {                                                // Stop, leave devices powered down //
+  if (_Running) _INA.setMode(INA_MODE_POWER_DOWN,_DeviceNumber);              // Power down any device converting //
+  _Running = false;                                                           // Duty cycle has stopped           //
+} // of method end()                                                          //                                  //
+/*******************************************************************************************************************
+** Method poll() has to be called regularly from loop(). It starts a conversion once the interval has passed and  **
+** returns true with the sample of a device when its conversion has finished, powering it down first so that      **
+** reading the registers doesn't start another conversion. Devices which have not finished by the time the next   **
+** conversion is due are not powered down, they are simply triggered again: writing the mode to the configuration **
+** register abandons the unfinished conversion and starts a new one. When there is nothing to do the sleep        **
+** handler is called and false is returned                                                                        **
+*******************************************************************************************************************/
+bool INA226_DutyCycle::poll(inaRawSample &sample) {                           // Trigger or read devices when due //
+  if (!_Running) return false;                                                // Nothing to do if not started     //
+  uint32_t elapsed = micros()-_LastTrigger;                                   // Time since the last trigger      //
+  if (elapsed>=_Interval) {                                                   // If the next conversion is due    //
+    trigger(_LastTrigger+_Interval);                                          // then start it and                //
+    elapsed = micros()-_LastTrigger;                                          // recompute the time               //
+  } // of if-then conversion due                                              //                                  //
+  if (_Remaining && elapsed>=_Conversion) {                                   // If conversions should have ended //
+    for(uint8_t i=0;i<_INA.getDeviceCount();i++) {                            // Loop for each device found       //
+      if (!_Pending[i] || !_INA.conversionReady(i)) continue;                 // Skip if read or still converting //
+      _INA.setMode(INA_MODE_POWER_DOWN,i);                                    // Power down, retains registers    //
+      _INA.getRawSample(sample,i);                                            // Read all 4 registers in one go   //
+      _Pending[i] = false;                                                    // Device has been read             //
+      _Remaining--;                                                           //                                  //
+      return true;                                                            // Return sample taken              //
+    } // for-next each device loop                                            //                                  //
+    return false;                                                             // Return, result due any moment    //
+  } // of if-then conversions should have ended                               //                                  //
+  if (_SleepHandler)                                                          // Sleep until the conversion ends  //
+    _SleepHandler(_Remaining ? _Conversion-elapsed : _Interval-elapsed);      // or the next one is due           //
+  return false;                                                               // Return nothing read              //
+} // of method poll()                                                         //                                  //
+/*******************************************************************************************************************
+** Method setSleepHandler() sets a function which is called from poll() with the number of microseconds the       **
+** processor may sleep for, or NULL for none                                                                      **
+*******************************************************************************************************************/
+void INA226_DutyCycle::setSleepHandler(void (*sleepHandler)                   // Called when there is nothing to  //
+                                        (const uint32_t microSeconds)) {      // do, NULL for none                //
+  _SleepHandler = sleepHandler;                                               // Store the handler, NULL for none //
+} // of method setSleepHandler()                                              //                                  //
+/*******************************************************************************************************************
+** Method trigger() wakes the devices for a single conversion by writing the triggered mode to their              **
+** configuration registers. The cycle keeps to the interval from begin() unless poll() was called too late for    **
+** that. If the interval is shorter than the longest conversion time plus the 10% by which the device may be      **
+** slower, every poll() would trigger again before a conversion finishes and no sample would ever be read, so the **
+** interval is lengthened to that                                                                                 **
+*******************************************************************************************************************/
+void INA226_DutyCycle::trigger(const uint32_t due) {                          // Wake devices for one conversion  //
+  uint32_t now = micros();                                                    // Time of the trigger              //
+  _INA.setMode(_Mode,_DeviceNumber);                                          // Writing the mode starts it       //
+  _LastTrigger = (now-due<_Interval) ? due : now;                             // Keep the pace if possible        //
+  _Remaining   = 0;                                                           // Work out which devices convert   //
+  _Conversion  = 0;                                                           // and how long they take           //
+  for(uint8_t i=0;i<_INA.getDeviceCount();i++) {                              // Loop for each device found       //
+    _Pending[i] = _DeviceNumber==UINT8_MAX ||                                 // Device is in the cycle if all are//
+                  _DeviceNumber%_INA.getDeviceCount()==i;                     // or it is the one selected        //
+    if (!_Pending[i]) continue;                                               // Skip devices not in the cycle    //
+    uint32_t period = _INA.getConversionMicros(i);                            // Count the devices and find the   //
+    if (period>_Conversion) _Conversion = period;                             // longest conversion period        //
+    _Remaining++;                                                             //                                  //
+  } // for-next each device loop                                              //                                  //
+  _Interval = _Requested;                                                     // Leave time for the conversions to//
+  if (_Interval<_Conversion+_Conversion/10)                                   // end, allowing for the 10% slower //
+    _Interval = _Conversion+_Conversion/10;                                   // timebase of the device at worst  //
+} // of method trigger()                                                      //----------------------------------//
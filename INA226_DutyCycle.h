@@ -0,0 +1,57 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_DutyCycle class, which runs INA226 devices in a duty cycle for battery  **
+** powered applications. Between measurements the devices are kept in power-down mode, drawing about 0.5uA        **
+** instead of 330uA. At each interval poll() wakes them for a single triggered conversion, and once a device has  **
+** finished poll() powers it down again and reads all four registers in one burst, returning one sample per call. **
+** Until the conversion time has passed the bus is not touched at all, so nothing is spent polling for the        **
+** result.                                                                                                        **
+**                                                                                                                **
+** An optional sleep handler set with setSleepHandler() is called from poll() whenever there is nothing to do,    **
+** with the number of microseconds until the next conversion is due or finished. It can put the processor to      **
+** sleep for up to that time, e.g. with the AVR "sleep_mode()" or the ESP32 "esp_light_sleep_start()". When       **
+** INA226_Class::setAlertInterrupt() and setAlertPinOnConversion() are used, the alert pin interrupt also wakes   **
+** the processor as soon as a conversion ends, and poll() only reads the devices after the alert has fired        **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_DutyCycle_h                                                    // Guard code definition            //
+  #define INA226_DutyCycle_h                                                  // Define the name inside guard code//
+  /*****************************************************************************************************************
+  ** Declare class header                                                                                         **
+  *****************************************************************************************************************/
+  class INA226_DutyCycle {                                                    // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_DutyCycle(INA226_Class &ina);                                    // Class constructor                //
+      ~INA226_DutyCycle();                                                    // Class destructor                 //
+      void     begin(const uint32_t intervalMillis,                           // Power down devices and start the //
+                     const uint8_t mode=INA_MODE_TRIGGERED_BOTH,              // duty cycle                       //
+                     const uint8_t deviceNumber=UINT8_MAX);                   //                                  //
+      void     end();                                                         // Stop, leave devices powered down //
+      bool     poll(inaRawSample &sample);                                    // Trigger or read devices when due //
+      void     setSleepHandler(void (*sleepHandler)                           // Called when there is nothing to  //
+                               (const uint32_t microSeconds));                // do, NULL for none                //
+    private:                                                                  // Private variables and methods    //
+      void     trigger(const uint32_t now);                                   // Wake devices for one conversion  //
+      INA226_Class &_INA;                                                     // Devices being sampled            //
+      void   (*_SleepHandler)(const uint32_t microSeconds) = NULL;            // Sleeps the processor if set      //
+      bool     _Running        = false;                                       // Set between begin() and end()    //
+      uint8_t  _Mode           = INA_MODE_TRIGGERED_BOTH;                     // Triggered mode used to convert   //
+      uint8_t  _DeviceNumber   = UINT8_MAX;                                   // Device or UINT8_MAX for all      //
+      uint8_t  _Remaining      = 0;                                           // Devices still converting         //
+      uint32_t _Requested      = 0;                                           // Interval given to begin() in us  //
+      uint32_t _Interval       = 0;                                           // Time between conversions in us   //
+      uint32_t _Conversion     = 0;                                           // Longest conversion period in us  //
+      uint32_t _LastTrigger    = 0;                                           // micros() of the last trigger     //
+      bool     _Pending[INA_MAX_DEVICES] = {};                                // Device has not been read yet     //
+  }; // of INA226_DutyCycle definition                                        //                                  //
+#endif                                                                        //----------------------------------//
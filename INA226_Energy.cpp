@@ -0,0 +1,92 @@
+/*******************************************************************************************************************
+** INA226_Energy class method definitions for INA226 Library.                                                     **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_Energy.h"                                                    // Include the header definition    //
+INA226_Energy::INA226_Energy(INA226_Class &ina) : _INA(ina) {}                // Class constructor                //
+INA226_Energy::~INA226_Energy() {}                                            // Unused class destructor          //
+/*******************************************************************************************************************
+** Method poll() checks whether the device has finished a conversion and if so reads the registers and adds them  **
+** to the totals, which also re-triggers the device in triggered mode. It returns true if a conversion was added. **
+** As conversionReady() only uses the bus after the alert pin has fired, when the alert interrupt is set up, this **
+** can be called as often as wanted                                                                               **
+*******************************************************************************************************************/
+bool INA226_Energy::poll(const uint8_t deviceNumber) {                        // Add a finished conversion        //
+  if (!_INA.conversionReady(deviceNumber)) return false;                      // Nothing to do if still converting//
+  inaRawSample sample;                                                        // Unconverted register values      //
+  _INA.getRawSample(sample,deviceNumber);                                     // Read all 4 registers             //
+  add(sample);                                                                // and add them to the totals       //
+  return true;                                                                // Return conversion added          //
+} // of method poll()                                                         //                                  //
+/*******************************************************************************************************************
+** Method add() adds one sample to the totals of its device, each register value weighted by the conversion       **
+** period of the device. It only does integer arithmetic and no I2C transfers, so it can be called from the       **
+** callback of INA226_Class::startRawSample()                                                                     **
+*******************************************************************************************************************/
+void INA226_Energy::add(const inaRawSample &sample) {                         // Add a sample read elsewhere      //
+  uint8_t  i      = _INA.deviceIndex(sample.deviceNumber);                    // Index of the device totals       //
+  uint32_t period = _INA.getConversionMicros(i);                              // Time the sample represents in us //
+  _Power[i]   += (int64_t)sample.power*period;                                // Add power register * period      //
+  _Current[i] += (int64_t)sample.current*period;                              // Add current register * period    //
+  _Micros[i]  += period;                                                      // Add the period                   //
+} // of method add()                                                          //                                  //
+/*******************************************************************************************************************
+** Method reset() sets the totals of one device or, by default, all of them back to 0                             **
+*******************************************************************************************************************/
+void INA226_Energy::reset(const uint8_t deviceNumber) {                       // Reset the accumulated totals     //
+  for(uint8_t i=0;i<INA_MAX_DEVICES;i++) {                                    // Loop for each table entry        //
+    if(deviceNumber==UINT8_MAX || _INA.deviceIndex(deviceNumber)==i) {        // If this device needs resetting   //
+      noInterrupts();                                                         // 64 bit values aren't atomic and  //
+      _Power[i]   = 0;                                                        // add() may run in an interrupt    //
+      _Current[i] = 0;                                                        //                                  //
+      _Micros[i]  = 0;                                                        //                                  //
+      interrupts();                                                           //                                  //
+    } // of if this device needs to be reset                                  //                                  //
+  } // for-next each device                                                   //                                  //
+} // of method reset()                                                        //                                  //
+/*******************************************************************************************************************
+** Methods getMicroWattHours(), getMicroAmpHours() and getMicroSeconds() return the energy, charge and time       **
+** accumulated for a device since the last reset(). The charge is corrected for the offset set with               **
+** INA226_Class::setTrim(), the offset in force when it is read applying to the whole period                      **
+*******************************************************************************************************************/
+int64_t INA226_Energy::getMicroWattHours(const uint8_t deviceNumber) {        // Energy since reset in uWh        //
+  noInterrupts();                                                             // 64 bit value isn't atomic        //
+  int64_t sum = _Power[_INA.deviceIndex(deviceNumber)];                       // Copy the total                   //
+  interrupts();                                                               //                                  //
+  return scale(sum,_INA.getPowerLSB(deviceNumber),INA_POWER_DIVISOR);         // Convert to uWh                   //
+} // of method getMicroWattHours()                                            //                                  //
+int64_t INA226_Energy::getMicroAmpHours(const uint8_t deviceNumber) {         // Charge since reset in uAh        //
+  noInterrupts();                                                             // 64 bit value isn't atomic        //
+  int64_t sum = _Current[_INA.deviceIndex(deviceNumber)]-                     // Copy the total less the setTrim()//
+                (int64_t)_INA.getCurrentOffset(deviceNumber)*                 // offset over the time integrated  //
+                (int64_t)_Micros[_INA.deviceIndex(deviceNumber)];             //                                  //
+  interrupts();                                                               //                                  //
+  return scale(sum,_INA.getCurrentLSB(deviceNumber),INA_CURRENT_DIVISOR);     // Convert to uAh                   //
+} // of method getMicroAmpHours()                                             //                                  //
+uint64_t INA226_Energy::getMicroSeconds(const uint8_t deviceNumber) {         // Time integrated since reset      //
+  noInterrupts();                                                             // 64 bit value isn't atomic        //
+  uint64_t sum = _Micros[_INA.deviceIndex(deviceNumber)];                     // Copy the total                   //
+  interrupts();                                                               //                                  //
+  return sum;                                                                 // Return the time                  //
+} // of method getMicroSeconds()                                              //                                  //
+/*******************************************************************************************************************
+** Method scale() converts a sum of register values times microseconds into hours times lsb/divisor. The sum is   **
+** split into whole hours and the remaining microseconds so that the multiplication by the LSB can't overflow 64  **
+** bits                                                                                                           **
+*******************************************************************************************************************/
+int64_t INA226_Energy::scale(const int64_t sum, const uint32_t lsb,           // Convert a sum of register value  //
+                             const uint32_t divisor) {                        // times microseconds to LSB hours  //
+  int64_t hours = sum/INA_MICROS_PER_HOUR;                                    // Whole hours of register value    //
+  int64_t rest  = sum%INA_MICROS_PER_HOUR;                                    // and the remainder                //
+  return (hours*lsb+rest*lsb/INA_MICROS_PER_HOUR)/divisor;                    // Combine and scale to units       //
+} // of method scale()                                                        //----------------------------------//
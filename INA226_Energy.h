@@ -0,0 +1,53 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_Energy class, which integrates the power and current readings of the    **
+** INA226 devices into energy in microwatt-hours and charge in microamp-hours. Each conversion result is the      **
+** average over one conversion period, so the accumulator adds the power and current registers multiplied by the  **
+** conversion period computed from the averaging and conversion time settings of the device (see                  **
+** INA226_Class::getConversionMicros()) rather than by measuring the time between readings with millis(). No      **
+** conversion is lost or counted twice as long as every conversion is read, best done by calling poll() when the  **
+** alert pin signals a finished conversion, or by passing the samples read in the background by                   **
+** INA226_Class::startRawSample() to add(). Results are only exact with the devices measuring continuously; in    **
+** triggered mode the readings only cover the conversions themselves.                                             **
+**                                                                                                                **
+** The state is kept as 64 bit sums of register value times microseconds and is only converted when read, so no   **
+** precision is lost between readings. The sums overflow after about 4.5 years at full scale power (register      **
+** 65535) and 8.9 years at full scale current (register 32767). Conversion uses the same LSB values as            **
+** getBusMicroAmps() and getBusMicroWatts() and the offset set by INA226_Class::setTrim().                        **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_Energy_h                                                       // Guard code definition            //
+  #define INA226_Energy_h                                                     // Define the name inside guard code//
+  const uint32_t INA_MICROS_PER_HOUR = 3600000000UL;                          // Microseconds in an hour          //
+  /*****************************************************************************************************************
+  ** Declare class header                                                                                         **
+  *****************************************************************************************************************/
+  class INA226_Energy {                                                       // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_Energy(INA226_Class &ina);                                       // Class constructor                //
+      ~INA226_Energy();                                                       // Class destructor                 //
+      bool     poll(const uint8_t deviceNumber=0);                            // Add a finished conversion        //
+      void     add(const inaRawSample &sample);                               // Add a sample read elsewhere      //
+      void     reset(const uint8_t deviceNumber=UINT8_MAX);                   // Reset the accumulated totals     //
+      int64_t  getMicroWattHours(const uint8_t deviceNumber=0);               // Energy since reset in uWh        //
+      int64_t  getMicroAmpHours(const uint8_t deviceNumber=0);                // Charge since reset in uAh        //
+      uint64_t getMicroSeconds(const uint8_t deviceNumber=0);                 // Time integrated since reset      //
+    private:                                                                  // Private variables and methods    //
+      int64_t  scale(const int64_t sum, const uint32_t lsb,                   // Convert a sum of register value  //
+                     const uint32_t divisor);                                 // times microseconds to LSB hours  //
+      INA226_Class &_INA;                                                     // Devices being integrated         //
+      int64_t  _Power[INA_MAX_DEVICES]   = {};                                // Sum of power register * us       //
+      int64_t  _Current[INA_MAX_DEVICES] = {};                                // Sum of current register * us     //
+      uint64_t _Micros[INA_MAX_DEVICES]  = {};                                // Sum of conversion periods in us  //
+  }; // of INA226_Energy definition                                           //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,122 @@
+/*******************************************************************************************************************
+** Class template definition for INA226_Fixed, a version of INA226_Class for boards where the shunt resistor and  **
+** maximum expected current are known when compiling. The two values that are otherwise passed to begin() are     **
+** given as template parameters, e.g. "INA226_Fixed<1,100000> INA226;" for +/-1 Amp with a 0.1 Ohm shunt, so the  **
+** calibration register value and the current and power LSBs become compile-time constants. The devices are then  **
+** started with beginFixed() instead of begin(maxBusAmps,microOhmR), which is deleted so that an existing sketch  **
+** calling it fails to compile rather than calibrating with other values than the template's. The conversions     **
+** from register values are reduced to constant fractions which the compiler turns into multiplies and shifts,    **
+** using 32 bit arithmetic whenever the result cannot overflow. Because begin(maxBusAmps,microOhmR) is not called **
+** the 64 bit division routines it requires are not linked into the program either.                               **
+**                                                                                                                **
+** The conversions are exact fractions of the untrimmed LSBs, rounded towards zero, while INA226_Class uses a     **
+** rounded fixed-point multiplier, so readings can differ from it in the last digit. Only the part of a setTrim() **
+** correction that goes into the calibration register has an effect, the LSB correction and the offset are        **
+** ignored. getBusMicroAmps(), getBusMicroWatts(), getAllReadings() and convertSample() hide the INA226_Class     **
+** methods of the same name rather than overriding them, as those aren't virtual, so they are only used when      **
+** called on an INA226_Fixed object. INA226_Sampler, INA226_Energy, INA226_Statistics and the other helper        **
+** classes take an INA226_Class reference and use the run time conversions of INA226_Class.                       **
+**                                                                                                                **
+** All other methods are inherited unchanged from INA226_Class. The template is header-only as the compiler needs **
+** to see the code in order to specialize it.                                                                     **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_Fixed_h                                                        // Guard code definition            //
+  #define INA226_Fixed_h                                                      // Define the name inside guard code//
+  /*****************************************************************************************************************
+  ** Greatest common divisor, used to reduce the conversion fractions while compiling                             **
+  *****************************************************************************************************************/
+  inline constexpr uint32_t inaGreatestCommonDivisor(const uint32_t a,        // Euclid's algorithm               //
+                                                     const uint32_t b) {      //                                  //
+    return b==0 ? a : inaGreatestCommonDivisor(b,a%b);                        //                                  //
+  } // of function inaGreatestCommonDivisor()                                 //                                  //
+  /*****************************************************************************************************************
+  ** Declare class template                                                                                       **
+  *****************************************************************************************************************/
+  template <uint8_t MaxBusAmps, uint32_t MicroOhmR>                           // Fixed current range and shunt    //
+  class INA226_Fixed : public INA226_Class {                                  // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      static constexpr uint32_t CURRENT_LSB =                                 // Same values as computed by       //
+                                (uint64_t)MaxBusAmps*1000000000/32767;        // INA226_Class::begin()            //
+      static constexpr uint32_t POWER_LSB   = (uint32_t)25*CURRENT_LSB;       //                                  //
+      static constexpr uint64_t SHUNT_LSB   =                                 // Divisor of calibration formula   //
+                                (uint64_t)CURRENT_LSB*MicroOhmR/100000;       //                                  //
+      static_assert(SHUNT_LSB>0,"INA226_Fixed shunt resistance too small");   // Catch a division by zero         //
+      static_assert((uint64_t)51200000/SHUNT_LSB<=0x7FFF,                     // Has to fit into the 15 bits of   //
+                    "INA226_Fixed calibration value too large");              // the calibration register         //
+      static constexpr uint16_t CALIBRATION = (uint64_t)51200000/SHUNT_LSB;   // Calibration register value       //
+      /*************************************************************************************************************
+      ** Method beginFixed() enumerates the devices and writes the precomputed calibration to one or all of them. **
+      ** It has its own name so that the two numbers of begin(maxBusAmps,microOhmR) can't be taken for a device   **
+      ** number and I2C speed, that begin() is deleted                                                            **
+      *************************************************************************************************************/
+      uint8_t beginFixed(const uint8_t  deviceNumber = UINT8_MAX,             // Class initializer                //
+                         const uint32_t i2cSpeed = INA_I2C_STANDARD_MODE) {   //                                  //
+        if (discover(i2cSpeed))                                               // If devices found then calibrate  //
+          setCalibration(CALIBRATION,CURRENT_LSB,POWER_LSB,deviceNumber);     //                                  //
+        return getDeviceCount();                                              // Return number of devices found   //
+      } // of method beginFixed()                                             //                                  //
+      uint8_t begin(const uint8_t maxBusAmps, const uint32_t microOhmR,       // The range is set by the template //
+                    const uint8_t deviceNumber = UINT8_MAX,                   // parameters, use beginFixed()     //
+                    const uint32_t i2cSpeed = INA_I2C_STANDARD_MODE) = delete;//                                  //
+      int32_t getBusMicroAmps(const uint8_t deviceNumber=0) {                 // Retrieve micro-amps              //
+        return microAmps(getRawCurrent(deviceNumber));                        // Convert the register value       //
+      } // of method getBusMicroAmps()                                        //                                  //
+      int32_t getBusMicroWatts(const uint8_t deviceNumber=0) {                // Retrieve micro-watts             //
+        return microWatts(getRawPower(deviceNumber));                         // Convert the register value       //
+      } // of method getBusMicroWatts()                                       //                                  //
+      void getAllReadings(inaReadings &readings,                              // Retrieve shunt, bus, power and   //
+                          const uint8_t deviceNumber=0) {                     // current in one bus transaction   //
+        inaRawSample sample;                                                  // Unconverted register values      //
+        getRawSample(sample,deviceNumber);                                    // Read all 4 registers             //
+        convertSample(sample,readings);                                       // and convert them                 //
+      } // of method getAllReadings()                                         //                                  //
+      void convertSample(const inaRawSample &sample, inaReadings &readings) { // Convert a raw sample to readings //
+        readings.shuntMicroVolts = (int32_t)sample.shunt*                     // Convert to microvolts            //
+                                   INA_SHUNT_VOLTAGE_LSB/10;                  //                                  //
+        readings.busMilliVolts   = (uint32_t)sample.bus*                      // Convert to millivolts            //
+                                   INA_BUS_VOLTAGE_LSB/100;                   //                                  //
+        readings.busMicroWatts   = microWatts(sample.power);                  // Convert to microwatts            //
+        readings.busMicroAmps    = microAmps(sample.current);                 // Convert to microamps             //
+      } // of method convertSample()                                          //                                  //
+      /*************************************************************************************************************
+      ** Methods microAmps() and microWatts() convert register values using the reduced constant fractions. The   **
+      ** results are exact, rounded towards zero, so they can differ in the last digit from INA226_Class which    **
+      ** rounds its multipliers, and the setTrim() LSB and offset corrections aren't applied. Power beyond        **
+      ** INT32_MAX saturates as it does in INA226_Class                                                           **
+      *************************************************************************************************************/
+      static int32_t microAmps(const int16_t raw) {                           // Convert current register         //
+        if ((uint64_t)32768*CURRENT_MUL<=INT32_MAX)                           // Use 32 bits if it can't overflow //
+          return (int32_t)raw*(int32_t)CURRENT_MUL/(int32_t)CURRENT_DIV;      //                                  //
+        return (int64_t)raw*CURRENT_MUL/CURRENT_DIV;                          // otherwise use 64 bits            //
+      } // of method microAmps()                                              //                                  //
+      static int32_t microWatts(const uint16_t raw) {                         // Convert power register           //
+        uint64_t value;                                                       // Result before saturating         //
+        if ((uint64_t)65535*POWER_MUL<=UINT32_MAX)                            // Use 32 bits if it can't overflow //
+          value = (uint32_t)raw*POWER_MUL/POWER_DIV;                          //                                  //
+        else                                                                  //                                  //
+          value = (uint64_t)raw*POWER_MUL/POWER_DIV;                          // otherwise use 64 bits            //
+        return value>INT32_MAX ? INT32_MAX : (int32_t)value;                  // Saturate like INA226_Class       //
+      } // of method microWatts()                                             //                                  //
+    private:                                                                  // Private variables and methods    //
+      static constexpr uint32_t CURRENT_GCD =                                 // Reduce the current conversion    //
+                                inaGreatestCommonDivisor(CURRENT_LSB,1000);   // fraction LSB/1000                //
+      static constexpr uint32_t CURRENT_MUL = CURRENT_LSB/CURRENT_GCD;        //                                  //
+      static constexpr uint32_t CURRENT_DIV = 1000/CURRENT_GCD;               //                                  //
+      static constexpr uint32_t POWER_GCD   =                                 // Reduce the power conversion      //
+                                inaGreatestCommonDivisor(POWER_LSB,1000);     // fraction LSB/1000                //
+      static constexpr uint32_t POWER_MUL   = POWER_LSB/POWER_GCD;            //                                  //
+      static constexpr uint32_t POWER_DIV   = 1000/POWER_GCD;                 //                                  //
+  }; // of INA226_Fixed definition                                            //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,149 @@
+/*******************************************************************************************************************
+** INA226_MultiBusSampler class method definitions for INA226 Library.                                            **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_MultiBus.h"                                                  // Include the header definition    //
+INA226_MultiBusSampler::INA226_MultiBusSampler(INA226_Class &ina)             // Class constructor                //
+  : _INA(ina) {}                                                              //                                  //
+/*******************************************************************************************************************
+** The class destructor stops any running tasks and releases the queue                                            **
+*******************************************************************************************************************/
+INA226_MultiBusSampler::~INA226_MultiBusSampler() {                           // Class destructor                 //
+  #if defined(ESP32)                                                          //                                  //
+    stop();                                                                   // Stop the bus tasks               //
+    if (_Queue) vQueueDelete(_Queue);                                         // and release the queue            //
+  #elif defined(ARDUINO_ARCH_RP2040)                                          //                                  //
+    if (_QueueCreated) queue_free(&_Queue);                                   // Release the queue                //
+  #endif                                                                      //                                  //
+} // of class destructor                                                      //                                  //
+/*******************************************************************************************************************
+** Method begin() creates the merged queue and makes a list of the I2C buses which have devices. It has to be     **
+** called after INA226_Class::begin(), returns false if the queue could not be created                            **
+*******************************************************************************************************************/
+bool INA226_MultiBusSampler::begin() {                                        // Create queue, find the buses     //
+  _BusCount = 0;                                                              // Rebuild the list of buses        //
+  for(uint8_t i=0;i<_INA.getDeviceCount();i++) {                              // Loop for each device found       //
+    TwoWire *bus = &_INA.getDeviceBus(i);                                     // Bus the device is connected to   //
+    uint8_t j = 0;                                                            // Look for bus in the list         //
+    while (j<_BusCount && _Buses[j]!=bus) j++;                                //                                  //
+    if (j==_BusCount && _BusCount<INA_MAX_BUSES) _Buses[_BusCount++] = bus;   // Add bus if not yet in the list   //
+  } // for-next each device                                                   //                                  //
+  #if defined(ESP32)                                                          //                                  //
+    if (!_Queue) _Queue = xQueueCreate(INA_MULTIBUS_QUEUE_SIZE,               // Create the FreeRTOS queue        //
+                                       sizeof(inaRawSample));                 //                                  //
+    return _Queue!=NULL;                                                      // Return success                   //
+  #elif defined(ARDUINO_ARCH_RP2040)                                          //                                  //
+    if (!_QueueCreated) {                                                     // Create the Pico SDK queue        //
+      queue_init(&_Queue,sizeof(inaRawSample),INA_MULTIBUS_QUEUE_SIZE);       //                                  //
+      _QueueCreated = true;                                                   //                                  //
+    } // of if-then queue not yet created                                     //                                  //
+    return true;                                                              // Return success                   //
+  #else                                                                       //                                  //
+    return true;                                                              // Buffer needs no initialization   //
+  #endif                                                                      //                                  //
+} // of method begin()                                                        //                                  //
+/*******************************************************************************************************************
+** Method serviceBus() checks every device on the given bus once and queues a raw sample from each device which   **
+** has finished a conversion, in triggered mode this also starts its next conversion. Only one task or core may   **
+** service a given bus, different buses may be serviced at the same time. Returns the number of samples queued    **
+*******************************************************************************************************************/
+uint8_t INA226_MultiBusSampler::serviceBus(TwoWire &bus) {                    // Read devices that are ready      //
+  uint8_t busIndex = 0;                                                       // Position of bus in the list      //
+  while (busIndex<_BusCount && _Buses[busIndex]!=&bus) busIndex++;            //                                  //
+  if (busIndex==_BusCount) return 0;                                          // No devices on this bus           //
+  uint8_t samples = 0;                                                        // Number of samples queued         //
+  inaRawSample sample;                                                        // Sample being read                //
+  for(uint8_t i=0;i<_INA.getDeviceCount();i++) {                              // Loop for each device found       //
+    if (&_INA.getDeviceBus(i)==&bus && _INA.conversionReady(i)) {             // If on this bus and finished      //
+      _INA.getRawSample(sample,i);                                            // Read the registers               //
+      #if defined(ESP32)                                                      //                                  //
+        bool queued = xQueueSend(_Queue,&sample,0)==pdTRUE;                   // Add to queue, don't wait if full //
+      #elif defined(ARDUINO_ARCH_RP2040)                                      //                                  //
+        bool queued = queue_try_add(&_Queue,&sample);                         // Add to queue, don't wait if full //
+      #else                                                                   //                                  //
+        bool queued = _Queue.push(sample);                                    // Add to buffer, dropped if full   //
+      #endif                                                                  //                                  //
+      if (queued) samples++;                                                  // Count the sample                 //
+             else _Overflows[busIndex]++;                                     // or count it as lost              //
+    } // of if-then device ready                                              //                                  //
+  } // for-next each device                                                   //                                  //
+  return samples;                                                             // Return number of samples queued  //
+} // of method serviceBus()                                                   //                                  //
+/*******************************************************************************************************************
+** Method read() takes the oldest sample from the merged queue, returns false if the queue was empty              **
+*******************************************************************************************************************/
+bool INA226_MultiBusSampler::read(inaRawSample &sample) {                     // Take next sample from the queue  //
+  #if defined(ESP32)                                                          //                                  //
+    return _Queue && xQueueReceive(_Queue,&sample,0)==pdTRUE;                 // Don't wait if empty              //
+  #elif defined(ARDUINO_ARCH_RP2040)                                          //                                  //
+    return _QueueCreated && queue_try_remove(&_Queue,&sample);                // Don't wait if empty              //
+  #else                                                                       //                                  //
+    return _Queue.pop(sample);                                                // Take sample from the buffer      //
+  #endif                                                                      //                                  //
+} // of method read()                                                         //                                  //
+/*******************************************************************************************************************
+** Method getOverflows() returns the total number of samples which were lost because the queue was full           **
+*******************************************************************************************************************/
+uint32_t INA226_MultiBusSampler::getOverflows() {                             // Samples lost, queue was full     //
+  uint32_t overflows = 0;                                                     // Sum over all buses               //
+  for(uint8_t i=0;i<_BusCount;i++) overflows += _Overflows[i];                // Add each bus counter             //
+  return overflows;                                                           // Return the total                 //
+} // of method getOverflows()                                                 //                                  //
+#if defined(ESP32)                                                            // FreeRTOS tasks                   //
+  /*****************************************************************************************************************
+  ** Method start() creates one task per bus, pinned to alternating cores, which services its bus continuously.   **
+  ** When no device on the bus is ready the task sleeps for one tick, leaving time for the other tasks on the     **
+  ** core. begin() has to have been called first. Returns false if a task could not be created                    **
+  *****************************************************************************************************************/
+  bool INA226_MultiBusSampler::start(const uint32_t stackSize,                // Start one task per bus           //
+                                     const UBaseType_t priority) {            //                                  //
+    if (!_Queue || _Running) return false;                                    // Needs a queue, only start once   //
+    _Running = true;                                                          // Tasks run until this is cleared  //
+    for(uint8_t i=0;i<_BusCount;i++) {                                        // Loop for each bus                //
+      _TaskInfo[i].sampler = this;                                            // Parameters passed to the task    //
+      _TaskInfo[i].bus     = _Buses[i];                                       //                                  //
+      BaseType_t created = xTaskCreatePinnedToCore(busTask,"INA226",stackSize,// Create the task on its own core  //
+                                                   &_TaskInfo[i],priority,    //                                  //
+                                                   &_Task[i],                 //                                  //
+                                                   i%portNUM_PROCESSORS);     //                                  //
+      if (created!=pdPASS) {                                                  // If the task couldn't be created  //
+        _Task[i] = NULL;                                                      // Task wasn't created              //
+        stop();                                                               // Stop those already started       //
+        return false;                                                         // and return failure               //
+      } // of if-then task not created                                        //                                  //
+    } // for-next each bus                                                    //                                  //
+    return true;                                                              // Return success                   //
+  } // of method start()                                                      //                                  //
+  /*****************************************************************************************************************
+  ** Method stop() asks the bus tasks to finish and waits until they have done so. The tasks end themselves after **
+  ** completing the current pass so that no I2C transaction is interrupted                                        **
+  *****************************************************************************************************************/
+  void INA226_MultiBusSampler::stop() {                                       // Stop all bus tasks               //
+    _Running = false;                                                         // Ask the tasks to finish          //
+    for(uint8_t i=0;i<_BusCount;i++) {                                        // Loop for each bus                //
+      while (_Task[i]) vTaskDelay(1);                                         // Wait until the task has ended    //
+    } // for-next each bus                                                    //                                  //
+  } // of method stop()                                                       //                                  //
+  /*****************************************************************************************************************
+  ** Method busTask() is the FreeRTOS task function which services one bus until stop() is called                 **
+  *****************************************************************************************************************/
+  void INA226_MultiBusSampler::busTask(void *parameter) {                     // Task function reading one bus    //
+    busTaskInfo *info = (busTaskInfo*)parameter;                              // Sampler and bus of this task     //
+    INA226_MultiBusSampler *sampler = info->sampler;                          //                                  //
+    while (sampler->_Running) {                                               // Loop until asked to stop         //
+      if (sampler->serviceBus(*info->bus)==0) vTaskDelay(1);                  // Sleep if nothing was ready       //
+    } // of while running                                                     //                                  //
+    sampler->_Task[info-sampler->_TaskInfo] = NULL;                           // Tell stop() the task has ended   //
+    vTaskDelete(NULL);                                                        // and delete this task             //
+  } // of method busTask()                                                    //                                  //
+#endif                                                                        //----------------------------------//
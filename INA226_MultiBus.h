@@ -0,0 +1,79 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_MultiBusSampler class. When the INA226 devices are spread over more     **
+** than one I2C bus (see INA226_Class::addBus()) the buses can be read at the same time, each from its own core   **
+** or task, with all samples merged into one thread-safe queue of raw samples for the main program to read.       **
+**                                                                                                                **
+** On the ESP32 start() creates one FreeRTOS task per bus, each pinned to its own core where there is more than   **
+** one, and the merged queue is a FreeRTOS queue. On the RP2040 the queue is a Pico SDK queue and the sketch runs **
+** serviceBus(Wire) from loop() and serviceBus(Wire1) from loop1(), so that each core drives its own bus. Other   **
+** processors use an INA226_SampleBuffer and serviceBus() has to be called for each bus from the same context.    **
+**                                                                                                                **
+** The devices have to be in continuous mode or triggered mode. The alert pin interrupt should not be used at the **
+** same time, as its flag is shared by all devices and would be cleared by whichever core reads first. The queue  **
+** length is set using INA_MULTIBUS_QUEUE_SIZE, which can be overridden by build flags                            **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_MultiBus_h                                                     // Guard code definition            //
+  #define INA226_MultiBus_h                                                   // Define the name inside guard code//
+  #ifndef INA_MULTIBUS_QUEUE_SIZE                                             // Can be overridden by build flags //
+    #define INA_MULTIBUS_QUEUE_SIZE 32                                        // Number of samples in the queue   //
+  #endif                                                                      //                                  //
+  #if defined(ESP32)                                                          // ESP32 uses FreeRTOS tasks and a  //
+    #include <freertos/FreeRTOS.h>                                            // FreeRTOS queue                   //
+    #include <freertos/queue.h>                                               //                                  //
+    #include <freertos/task.h>                                                //                                  //
+  #elif defined(ARDUINO_ARCH_RP2040)                                          // RP2040 uses the Pico SDK queue,  //
+    #include <pico/util/queue.h>                                              // which is safe between cores      //
+  #else                                                                       // Everything else uses the single  //
+    #include "INA226_SampleBuffer.h"                                          // producer and consumer buffer     //
+  #endif                                                                      //                                  //
+  /*****************************************************************************************************************
+  ** Declare class header                                                                                         **
+  *****************************************************************************************************************/
+  class INA226_MultiBusSampler {                                              // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_MultiBusSampler(INA226_Class &ina);                              // Class constructor                //
+      ~INA226_MultiBusSampler();                                              // Class destructor                 //
+      bool     begin();                                                       // Create queue, find the buses     //
+      uint8_t  serviceBus(TwoWire &bus);                                      // Read devices that are ready      //
+      bool     read(inaRawSample &sample);                                    // Take next sample from the queue  //
+      uint32_t getOverflows();                                                // Samples lost, queue was full     //
+      #if defined(ESP32)                                                      // Tasks only on FreeRTOS           //
+        bool   start(const uint32_t stackSize=2048,                           // Start one task per bus           //
+                     const UBaseType_t priority=1);                           //                                  //
+        void   stop();                                                        // Stop all bus tasks               //
+      #endif                                                                  //                                  //
+    private:                                                                  // Private variables and methods    //
+      INA226_Class &_INA;                                                     // Devices being sampled            //
+      uint8_t  _BusCount = 0;                                                 // Number of buses with devices     //
+      TwoWire *_Buses[INA_MAX_BUSES];                                         // Buses with devices               //
+      volatile uint32_t _Overflows[INA_MAX_BUSES] = {};                       // Lost samples, one writer per bus //
+      #if defined(ESP32)                                                      //                                  //
+        typedef struct {                                                      // Parameters passed to a bus task  //
+          INA226_MultiBusSampler *sampler;                                    // Sampler the task belongs to      //
+          TwoWire                *bus;                                        // Bus the task reads               //
+        } busTaskInfo; // of structure                                        //                                  //
+        static void   busTask(void *parameter);                               // Task function reading one bus    //
+        QueueHandle_t _Queue = NULL;                                          // Merged sample queue              //
+        TaskHandle_t  _Task[INA_MAX_BUSES] = {};                              // Task of each bus                 //
+        busTaskInfo   _TaskInfo[INA_MAX_BUSES];                               // Parameters of each task          //
+        volatile bool _Running = false;                                       // Cleared to make the tasks stop   //
+      #elif defined(ARDUINO_ARCH_RP2040)                                      //                                  //
+        queue_t       _Queue;                                                 // Merged sample queue              //
+        bool          _QueueCreated = false;                                  // Set once the queue exists        //
+      #else                                                                   //                                  //
+        INA226_SampleBuffer _Queue;                                           // Merged sample queue              //
+      #endif                                                                  //                                  //
+  }; // of INA226_MultiBusSampler definition                                  //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,73 @@
+/*******************************************************************************************************************
+** INA226_RecordWriter class method definitions for INA226 Library.                                               **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_Record.h"                                                    // Include the header definition    //
+INA226_RecordWriter::INA226_RecordWriter(Print &output, const bool useCRC)    // Class constructor                //
+  : _Output(output), _UseCRC(useCRC) {}                                       //                                  //
+INA226_RecordWriter::~INA226_RecordWriter() {}                                // Unused class destructor          //
+/*******************************************************************************************************************
+** Method write() encodes a sample as described in INA226_Record.h and writes it to the output with a single      **
+** call, so that buffered outputs such as Serial send it in one piece. Returns the number of bytes written, which **
+** is less than the record length if the output could not take all of it                                          **
+*******************************************************************************************************************/
+uint8_t INA226_RecordWriter::write(const inaRawSample &sample) {              // Write one sample as a record     //
+  uint8_t  record[INA_RECORD_MAX_SIZE];                                       // Record being built               //
+  uint8_t  length = 2;                                                        // Sync and header come first       //
+  uint32_t delta  = sample.microSeconds-_LastMicros;                          // Time since the previous record   //
+  record[0] = INA_RECORD_SYNC;                                                // Sync byte                        //
+  record[1] = sample.deviceNumber&INA_RECORD_DEVICE_MASK;                     // Header with the device number    //
+  if (_UseCRC) record[1] |= INA_RECORD_CRC;                                   // and the flags                    //
+  if (_Records==0 || delta>UINT16_MAX) {                                      // If a full timestamp is due       //
+    record[1] |= INA_RECORD_FULL_TIME;                                        // then flag it and store all 4     //
+    delta = sample.microSeconds;                                              // bytes of the time                //
+    record[length++] = delta;                                                 //                                  //
+    record[length++] = delta>>8;                                              //                                  //
+    record[length++] = delta>>16;                                             //                                  //
+    record[length++] = delta>>24;                                             //                                  //
+  } else {                                                                    // otherwise just the 2 bytes of    //
+    record[length++] = delta;                                                 // the difference                   //
+    record[length++] = delta>>8;                                              //                                  //
+  } // of if-then-else full timestamp                                         //                                  //
+  const uint16_t registers[4] = {(uint16_t)sample.shunt,sample.bus,           // Registers in the order of the    //
+                                 sample.power,(uint16_t)sample.current};      // format description               //
+  for(uint8_t i=0;i<4;i++) {                                                  // Loop for each register           //
+    record[length++] = registers[i];                                          // Store least significant byte     //
+    record[length++] = registers[i]>>8;                                       // first                            //
+  } // for-next each register                                                 //                                  //
+  if (_UseCRC) {                                                              // Add the CRC of everything after  //
+    record[length] = crc8(&record[1],length-1);                               // the sync byte                    //
+    length++;                                                                 //                                  //
+  } // of if-then CRC used                                                    //                                  //
+  _LastMicros = sample.microSeconds;                                          // Keep the time for the next delta //
+  if (++_Records>=INA_RECORD_FULL_INTERVAL) _Records = 0;                     // Count towards the next full time //
+  return _Output.write(record,length);                                        // Write the record in one call     //
+} // of method write()                                                        //                                  //
+/*******************************************************************************************************************
+** Method restart() makes the next record carry a full timestamp, e.g. after the output has been reconnected      **
+*******************************************************************************************************************/
+void INA226_RecordWriter::restart() {                                         // Next record has a full timestamp //
+  _Records = 0;                                                               // Full timestamp is due            //
+} // of method restart()                                                      //                                  //
+/*******************************************************************************************************************
+** Method crc8() computes the CRC-8/SMBUS of a block of bytes one bit at a time, which needs no table in memory   **
+*******************************************************************************************************************/
+uint8_t INA226_RecordWriter::crc8(const uint8_t *data, const uint8_t length) {// CRC-8/SMBUS of a block of bytes  //
+  uint8_t crc = 0;                                                            // Initial value                    //
+  for(uint8_t i=0;i<length;i++) {                                             // Loop for each byte               //
+    crc ^= data[i];                                                           // Add the byte                     //
+    for(uint8_t bit=0;bit<8;bit++)                                            // and divide by the polynomial     //
+      crc = (crc&0x80) ? (uint8_t)((crc<<1)^0x07) : (uint8_t)(crc<<1);        // one bit at a time                //
+  } // for-next each byte                                                     //                                  //
+  return crc;                                                                 // Return the CRC                   //
+} // of method crc8()                                                         //----------------------------------//
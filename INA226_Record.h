@@ -0,0 +1,68 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_RecordWriter class, which writes raw samples as compact binary records  **
+** to any Print or Stream, e.g. Serial, a file on an SD card or a network client. A record takes 13 bytes, or 15  **
+** when it carries the full timestamp, instead of the 40 or more characters needed to print the converted         **
+** readings as text, and none of the conversion or formatting work is done on the microcontroller. The register   **
+** values are stored unchanged, so the host converts them with the LSB values from getCurrentLSB() and            **
+** getPowerLSB().                                                                                                 **
+**                                                                                                                **
+** Record format, multi-byte values little-endian:                                                                **
+**                                                                                                                **
+**   Offset Size Contents                                                                                         **
+**   ====== ==== =======================================================================================          **
+**        0    1 Sync byte 0xA5                                                                                   **
+**        1    1 Header, bits 0-4 device number, bit 5 is 0, bit 6 set if a CRC follows the registers and         **
+**               bit 7 set if the timestamp is the full 32 bit micros() value                                     **
+**        2  2/4 Timestamp, full micros() of the sample if header bit 7 is set, otherwise the microseconds        **
+**               since the previous record (of any device) as an unsigned 16 bit value                            **
+**      4/6    2 Shunt voltage register, signed, 2.5uV per bit                                                    **
+**      6/8    2 Bus voltage register, unsigned, 1.25mV per bit                                                   **
+**     8/10    2 Power register, unsigned, power LSB per bit                                                      **
+**    10/12    2 Current register, signed, current LSB per bit                                                    **
+**    12/14    1 Optional CRC-8/SMBUS (polynomial 0x07, initial value 0, not reflected) over the bytes from       **
+**               the header to the end of the current register                                                    **
+**                                                                                                                **
+** A record with a full timestamp is written first, whenever more than 65535us have passed since the previous     **
+** record and at least every INA_RECORD_FULL_INTERVAL records, so a decoder joining the stream or losing a record **
+** resyncs its clock. To decode, search for the sync byte, read the header to get the record length, check the    **
+** CRC if present and otherwise skip to the next sync byte. Then add the delta to the previous record time.       **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_Record_h                                                       // Guard code definition            //
+  #define INA226_Record_h                                                     // Define the name inside guard code//
+  #ifndef INA_RECORD_FULL_INTERVAL                                            // Can be overridden by build flags //
+    #define INA_RECORD_FULL_INTERVAL 64                                       // Records between full timestamps  //
+  #endif                                                                      //                                  //
+  const uint8_t  INA_RECORD_SYNC              =   0xA5;                       // First byte of every record       //
+  const uint8_t  INA_RECORD_DEVICE_MASK       =   0x1F;                       // Header bits 0-4, device number   //
+  const uint8_t  INA_RECORD_CRC               =   0x40;                       // Header bit 6, CRC follows        //
+  const uint8_t  INA_RECORD_FULL_TIME         =   0x80;                       // Header bit 7, 32 bit timestamp   //
+  const uint8_t  INA_RECORD_MAX_SIZE          =     15;                       // Longest record in bytes          //
+  /*****************************************************************************************************************
+  ** Declare class header                                                                                         **
+  *****************************************************************************************************************/
+  class INA226_RecordWriter {                                                 // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_RecordWriter(Print &output, const bool useCRC=true);             // Class constructor                //
+      ~INA226_RecordWriter();                                                 // Class destructor                 //
+      uint8_t  write(const inaRawSample &sample);                             // Write one sample as a record     //
+      void     restart();                                                     // Next record has a full timestamp //
+      static uint8_t crc8(const uint8_t *data, const uint8_t length);         // CRC-8/SMBUS of a block of bytes  //
+    private:                                                                  // Private variables and methods    //
+      Print   &_Output;                                                       // Where records are written        //
+      bool     _UseCRC;                                                       // Append a CRC to each record      //
+      uint32_t _LastMicros = 0;                                               // Timestamp of the previous record //
+      uint8_t  _Records    = 0;                                               // Records since a full timestamp   //
+  }; // of INA226_RecordWriter definition                                     //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,74 @@
+/*******************************************************************************************************************
+** INA226_SampleBuffer class method definitions for INA226 Library.                                               **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_SampleBuffer.h"                                              // Include the header definition    //
+#if defined(__AVR__)                                                          // Single core, so only stop the    //
+  #define INA_MEMORY_BARRIER() asm volatile("" ::: "memory")                  // compiler from reordering         //
+#else                                                                         // Other processors might have more //
+  #define INA_MEMORY_BARRIER() __sync_synchronize()                           // than one core, use a full barrier//
+#endif                                                                        //                                  //
+const uint8_t INA_SAMPLE_BUFFER_MASK = INA_SAMPLE_BUFFER_SIZE-1;              // Mask to turn index into a slot   //
+INA226_SampleBuffer::INA226_SampleBuffer()  {}                                // Class constructor                //
+INA226_SampleBuffer::~INA226_SampleBuffer() {}                                // Unused class destructor          //
+/*******************************************************************************************************************
+** Method push() is called by the producer to add a sample to the buffer. The sample is copied into its slot      **
+** before the head index is advanced so that the consumer never sees a half written sample. If the buffer is full **
+** the sample is dropped, the overflow counter incremented and false is returned                                  **
+*******************************************************************************************************************/
+bool INA226_SampleBuffer::push(const inaRawSample &sample) {                  // Producer: add a sample           //
+  uint8_t head = _Head;                                                       // Only the producer changes head   //
+  if ((uint8_t)(head-_Tail)>=INA_SAMPLE_BUFFER_SIZE) {                        // If the buffer is full then       //
+    _Overflows++;                                                             // count the lost sample            //
+    return false;                                                             // and return failure               //
+  } // of if-then buffer full                                                 //                                  //
+  _Samples[head&INA_SAMPLE_BUFFER_MASK] = sample;                             // Copy the sample into its slot    //
+  INA_MEMORY_BARRIER();                                                       // Sample is stored before the index//
+  _Head = head+1;                                                             // Publish the sample               //
+  return true;                                                                // Return success                   //
+} // of method push()                                                         //                                  //
+/*******************************************************************************************************************
+** Method pop() is called by the consumer to remove the oldest sample from the buffer. Returns false if the       **
+** buffer was empty, in which case "sample" is left unchanged                                                     **
+*******************************************************************************************************************/
+bool INA226_SampleBuffer::pop(inaRawSample &sample) {                         // Consumer: remove oldest sample   //
+  uint8_t tail = _Tail;                                                       // Only the consumer changes tail   //
+  if (tail==_Head) return false;                                              // Nothing to return if empty       //
+  INA_MEMORY_BARRIER();                                                       // Read head before the sample      //
+  sample = _Samples[tail&INA_SAMPLE_BUFFER_MASK];                             // Copy the sample out of its slot  //
+  INA_MEMORY_BARRIER();                                                       // Sample is copied before the index//
+  _Tail = tail+1;                                                             // Free the slot                    //
+  return true;                                                                // Return success                   //
+} // of method pop()                                                          //                                  //
+/*******************************************************************************************************************
+** Method available() returns the number of samples currently held in the buffer                                  **
+*******************************************************************************************************************/
+uint8_t INA226_SampleBuffer::available() {                                    // Number of samples buffered       //
+  return (uint8_t)(_Head-_Tail);                                              // Indices wrap around at 256       //
+} // of method available()                                                    //                                  //
+/*******************************************************************************************************************
+** Method getOverflows() returns the number of samples which were dropped because the buffer was full since the   **
+** previous call. It is a consumer method, the producer's counter isn't written so no locking is needed           **
+*******************************************************************************************************************/
+uint8_t INA226_SampleBuffer::getOverflows() {                                 // Samples lost since last call     //
+  uint8_t overflows = _Overflows;                                             // Take a copy of the counter       //
+  uint8_t lost      = overflows-_OverflowsSeen;                               // Compute the new overflows        //
+  _OverflowsSeen    = overflows;                                              // and remember what was reported   //
+  return lost;                                                                // Return number of samples lost    //
+} // of method getOverflows()                                                 //                                  //
+/*******************************************************************************************************************
+** Method clear() is called by the consumer to discard all samples currently in the buffer                        **
+*******************************************************************************************************************/
+void INA226_SampleBuffer::clear() {                                           // Consumer: discard all samples    //
+  _Tail = _Head;                                                              // Mark everything as read          //
+} // of method clear()                                                        //----------------------------------//
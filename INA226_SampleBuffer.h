@@ -0,0 +1,53 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_SampleBuffer class. This is a fixed size ring buffer of unconverted     **
+** INA226 samples, each sample holding the 4 measurement registers of one device along with a timestamp. It has a **
+** single producer and a single consumer which need no locking between them: push() may be called from within an  **
+** interrupt handler while the main loop calls pop(), or vice versa. Only the producer writes the head index and  **
+** only the consumer writes the tail index, both are 8 bit values so that reading them is atomic even on AVR.     **
+** Storing raw samples keeps the conversion and any statistics out of the time-critical path.                     **
+**                                                                                                                **
+** The buffer size is set using INA_SAMPLE_BUFFER_SIZE, which has to be a power of 2 no larger than 128 and can   **
+** be overridden by build flags. Each sample takes 13 bytes of RAM (16 on 32 bit processors)                      **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_SampleBuffer_h                                                 // Guard code definition            //
+  #define INA226_SampleBuffer_h                                               // Define the name inside guard code//
+  #ifndef INA_SAMPLE_BUFFER_SIZE                                              // Can be overridden by build flags //
+    #define INA_SAMPLE_BUFFER_SIZE 16                                         // Number of samples in the buffer  //
+  #endif                                                                      //                                  //
+  #if INA_SAMPLE_BUFFER_SIZE>128                                              // Indices are 8 bits and wrap, so  //
+    #error INA_SAMPLE_BUFFER_SIZE has to be a power of 2 no larger than 128   // the size must divide 256         //
+  #elif (INA_SAMPLE_BUFFER_SIZE&(INA_SAMPLE_BUFFER_SIZE-1))!=0                //                                  //
+    #error INA_SAMPLE_BUFFER_SIZE has to be a power of 2 no larger than 128   //                                  //
+  #endif                                                                      //                                  //
+  /*****************************************************************************************************************
+  ** Declare class header                                                                                         **
+  *****************************************************************************************************************/
+  class INA226_SampleBuffer {                                                 // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_SampleBuffer();                                                  // Class constructor                //
+      ~INA226_SampleBuffer();                                                 // Class destructor                 //
+      bool     push(const inaRawSample &sample);                              // Producer: add a sample           //
+      bool     pop(inaRawSample &sample);                                     // Consumer: remove oldest sample   //
+      uint8_t  available();                                                   // Number of samples buffered       //
+      uint8_t  getOverflows();                                                // Samples lost since last call     //
+      void     clear();                                                       // Consumer: discard all samples    //
+    private:                                                                  // Private variables and methods    //
+      inaRawSample     _Samples[INA_SAMPLE_BUFFER_SIZE];                      // Sample storage                   //
+      volatile uint8_t _Head      = 0;                                        // Next slot to write, producer only//
+      volatile uint8_t _Tail      = 0;                                        // Next slot to read, consumer only //
+      volatile uint8_t _Overflows = 0;                                        // Samples dropped, buffer was full //
+      uint8_t          _OverflowsSeen = 0;                                    // Overflows already reported       //
+  }; // of INA226_SampleBuffer definition                                     //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,92 @@
+/*******************************************************************************************************************
+** INA226_Sampler class method definitions for INA226 Library.                                                    **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_Sampler.h"                                                   // Include the header definition    //
+INA226_Sampler::INA226_Sampler(INA226_Class &ina) : _INA(ina) {}              // Class constructor                //
+INA226_Sampler::~INA226_Sampler() {}                                          // Unused class destructor          //
+/*******************************************************************************************************************
+** Method start() uses INA226_Class::triggerAll() to write the configuration register of every device back to     **
+** back, which starts a new conversion on all of them in triggered mode and restarts the conversion cycle in      **
+** continuous mode. It should be called once after the devices have been configured, from then on poll() keeps    **
+** the triggered devices converting                                                                               **
+*******************************************************************************************************************/
+void INA226_Sampler::start() {                                                // Start conversions on all devices //
+  _INA.triggerAll();                                                          // Start all conversions together   //
+  _NextDevice = 0;                                                            // Start checking from first device //
+} // of method start()                                                        //                                  //
+/*******************************************************************************************************************
+** Method poll() checks each device once, starting with the one after the device last read so that all devices    **
+** get an equal share of the bus. The first device found with a finished conversion is read into "readings",      **
+** which also re-triggers it in triggered mode, and its device number is returned. UINT8_MAX is returned if none  **
+** of the devices had a conversion ready                                                                          **
+*******************************************************************************************************************/
+uint8_t INA226_Sampler::poll(inaReadings &readings) {                         // Harvest next finished device     //
+  uint8_t deviceCount = _INA.getDeviceCount();                                // Number of devices to check       //
+  for(uint8_t i=0;i<deviceCount;i++) {                                        // Check every device once          //
+    uint8_t deviceNumber = (_NextDevice+i)%deviceCount;                       // Continue from the last one read  //
+    if (_INA.conversionReady(deviceNumber)) {                                 // If a conversion has finished     //
+      read(readings,deviceNumber);                                            // read it, triggers the next one   //
+      _NextDevice = deviceNumber+1;                                           // Check the next device first      //
+      return deviceNumber;                                                    // Return the device just read      //
+    } // of if-then conversion finished                                       //                                  //
+  } // for-next each device                                                   //                                  //
+  return UINT8_MAX;                                                           // Nothing ready yet                //
+} // of method poll()                                                         //                                  //
+/*******************************************************************************************************************
+** Method sampleAll() collects one set of readings from every device into the "readings" array, which must have   **
+** space for all devices, "readings[n]" holding device n. Devices are read in the order in which they finish      **
+** rather than in device order. The wait is bounded by twice the longest conversion time plus 10ms, the number of **
+** devices which were read is returned                                                                            **
+*******************************************************************************************************************/
+uint8_t INA226_Sampler::sampleAll(inaReadings readings[]) {                   // One reading from every device    //
+  uint8_t  deviceCount = _INA.getDeviceCount();                               // Number of devices to read        //
+  bool     pending[INA_MAX_DEVICES];                                          // Devices still to be read         //
+  uint32_t timeout     = 0;                                                   // Longest conversion time          //
+  for(uint8_t i=0;i<deviceCount;i++) {                                        // Loop for each device found       //
+    pending[i] = true;                                                        // Device not yet read              //
+    uint32_t conversionMicros = _INA.getConversionMicros(i);                  // Conversion time of this device   //
+    if (conversionMicros>timeout) timeout = conversionMicros;                 // Keep the longest time            //
+  } // for-next each device loop                                              //                                  //
+  timeout = 2*timeout+10000;                                                  // Same limit as waitForConversion()//
+  uint8_t  samples     = 0;                                                   // Number of devices read           //
+  uint32_t startMicros = micros();                                            // Start time of the wait           //
+  while(samples<deviceCount && micros()-startMicros<=timeout) {               // Loop until all read or timed out //
+    for(uint8_t i=0;i<deviceCount;i++) {                                      // Check each device still pending  //
+      if (pending[i] && _INA.conversionReady(i)) {                            // If a conversion has finished     //
+        read(readings[i],i);                                                  // read it, triggers the next one   //
+        pending[i] = false;                                                   // Device has been read             //
+        samples++;                                                            // Increment the counter            //
+      } // of if-then conversion finished                                     //                                  //
+    } // for-next each device                                                 //                                  //
+  } // of while devices still pending                                         //                                  //
+  return samples;                                                             // Return number of devices read    //
+} // of method sampleAll()                                                    //                                  //
+/*******************************************************************************************************************
+** Method setStatistics() attaches an INA226_Statistics instance which poll() and sampleAll() add each reading    **
+** to, NULL detaches it again                                                                                     **
+*******************************************************************************************************************/
+void INA226_Sampler::setStatistics(INA226_Statistics *statistics) {           // Add readings to statistics       //
+  _Statistics = statistics;                                                   // Store the statistics to use      //
+} // of method setStatistics()                                                //                                  //
+/*******************************************************************************************************************
+** Method read() reads all registers of a device, adds them to the statistics if they are attached and converts   **
+** them into "readings"                                                                                           **
+*******************************************************************************************************************/
+void INA226_Sampler::read(inaReadings &readings,                              // Read a device and add statistics //
+                          const uint8_t deviceNumber) {                       //                                  //
+  inaRawSample sample;                                                        // Unconverted register values      //
+  _INA.getRawSample(sample,deviceNumber);                                     // Read all 4 registers             //
+  if (_Statistics!=NULL) _Statistics->add(sample);                            // Add them to the statistics       //
+  _INA.convertSample(sample,readings);                                        // and convert them                 //
+} // of method read()                                                         //----------------------------------//
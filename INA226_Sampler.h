@@ -0,0 +1,44 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_Sampler class. This class sits on top of an INA226_Class instance and   **
+** samples all of the INA226 devices found in a round-robin fashion. Instead of waiting for each device in turn   **
+** it harvests whichever device has finished a conversion, so that the I2C reads of one device overlap with the   **
+** conversion time of all the others. In triggered mode each device is re-triggered as soon as it has been read,  **
+** the conversions are thus pipelined and the aggregate sample rate approaches that of the I2C bus itself rather  **
+** than the sum of all the device conversion times.                                                               **
+**                                                                                                                **
+** An INA226_Statistics instance can be attached with setStatistics(), every reading the sampler takes is then    **
+** also added to the statistics of its device straight from the raw register values.                              **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#include "INA226_Statistics.h"                                                // Statistics of the readings       //
+#ifndef INA226_Sampler_h                                                      // Guard code definition            //
+  #define INA226_Sampler_h                                                    // Define the name inside guard code//
+  /*****************************************************************************************************************
+  ** Declare class header                                                                                         **
+  *****************************************************************************************************************/
+  class INA226_Sampler {                                                      // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_Sampler(INA226_Class &ina);                                      // Class constructor                //
+      ~INA226_Sampler();                                                      // Class destructor                 //
+      void     start();                                                       // Start conversions on all devices //
+      uint8_t  poll(inaReadings &readings);                                   // Harvest next finished device     //
+      uint8_t  sampleAll(inaReadings readings[]);                             // One reading from every device    //
+      void     setStatistics(INA226_Statistics *statistics);                  // Add readings to statistics       //
+    private:                                                                  // Private variables and methods    //
+      INA226_Class &_INA;                                                     // Devices being sampled            //
+      void     read(inaReadings &readings, const uint8_t deviceNumber);       // Read a device and add statistics //
+      uint8_t  _NextDevice = 0;                                               // Next device to check for a result//
+      INA226_Statistics *_Statistics = NULL;                                  // Statistics to add readings to    //
+  }; // of INA226_Sampler definition                                          //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,321 @@
+/*******************************************************************************************************************
+** INA226_SimTransport and INA226_SimStorage class method definitions for INA226 Library.                         **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_Sim.h"                                                       // Include the header definition    //
+INA226_SimTransport::INA226_SimTransport() {}                                 // Class constructor                //
+/*******************************************************************************************************************
+** Method addDevice adds a simulated INA226 at the given I2C address, starting up in its power-on state with both **
+** inputs at 0. Returns the index used by the other methods, or UINT8_MAX if there is no space left or the address**
+** is already in use                                                                                              **
+*******************************************************************************************************************/
+uint8_t INA226_SimTransport::addDevice(const uint8_t address) {               // Add a simulated device           //
+  if (_DeviceCount>=INA_SIM_MAX_DEVICES || find(address)) return UINT8_MAX;   // Return if no space or duplicate  //
+  inaSimDevice &dev   = _Device[_DeviceCount];                                // Fill the next free entry         //
+  dev.address         = address;                                              // Store the address                //
+  dev.shuntMicroVolts = 0;                                                    // Nothing measured yet             //
+  dev.busMilliVolts   = 0;                                                    //                                  //
+  resetDevice(dev);                                                           // Power-on state                   //
+  return _DeviceCount++;                                                      // Return the index used            //
+} // of method addDevice()                                                    //                                  //
+/*******************************************************************************************************************
+** Method setInputs sets the shunt and bus voltages a simulated device measures from its next conversion onwards  **
+*******************************************************************************************************************/
+void INA226_SimTransport::setInputs(const uint8_t index,                      // Set the voltages a device        //
+                                    const int32_t shuntMicroVolts,            // measures                         //
+                                    const uint16_t busMilliVolts) {           //                                  //
+  if (index>=_DeviceCount) return;                                            // Ignore unknown devices           //
+  _Device[index].shuntMicroVolts = shuntMicroVolts;                           // Store the new inputs             //
+  _Device[index].busMilliVolts   = busMilliVolts;                             //                                  //
+} // of method setInputs()                                                    //                                  //
+/*******************************************************************************************************************
+** Method getRegister returns the current contents of one of the registers 0 to 7 of a simulated device without   **
+** causing any of the side effects of a read, such as clearing the flags                                          **
+*******************************************************************************************************************/
+uint16_t INA226_SimTransport::getRegister(const uint8_t index,                // Inspect a device register        //
+                                          const uint8_t reg) {                //                                  //
+  if (index>=_DeviceCount || reg>=8) return 0;                                // Return 0 if it doesn't exist     //
+  update(_Device[index]);                                                     // Complete any conversion now due  //
+  return _Device[index].reg[reg];                                             // Return the register contents     //
+} // of method getRegister()                                                  //                                  //
+/*******************************************************************************************************************
+** Method getAlertPin returns the level of the alert pin of a simulated device as digitalRead() would see it. The **
+** pin is active when the alert function flag is set or, with alert on conversion ready, a conversion is ready.   **
+** Active means LOW unless the polarity bit of the mask/enable register is set                                    **
+*******************************************************************************************************************/
+uint8_t INA226_SimTransport::getAlertPin(const uint8_t index) {               // Level of a device's alert pin    //
+  if (index>=_DeviceCount) return HIGH;                                       // Pulled up if it doesn't exist    //
+  inaSimDevice &dev = _Device[index];                                         // Reference the device             //
+  update(dev);                                                                // Complete any conversion now due  //
+  uint16_t mask = dev.reg[INA_MASK_ENABLE_REGISTER];                          // Mask/enable register contents    //
+  bool active   = (mask&INA_SIM_ALERT_FLAG) ||                                // Limit exceeded or conversion     //
+                  ((mask&INA_SIM_ALERT_ON_CONVERSION) &&                      // ready with alert on conversion   //
+                   (mask&INA_CONVERSION_READY_MASK));                         //                                  //
+  if (mask&INA_SIM_ALERT_POLARITY) return active ? HIGH : LOW;                // Active-high polarity             //
+  return active ? LOW : HIGH;                                                 // Default active-low polarity      //
+} // of method getAlertPin()                                                  //                                  //
+/*******************************************************************************************************************
+** Methods getTransactions, getBytes and resetCounters report and reset the bus traffic counters. Every write()   **
+** and read() call is one transaction, the bytes include the address byte of each transaction                     **
+*******************************************************************************************************************/
+uint32_t INA226_SimTransport::getTransactions() {                             // I2C transactions since reset     //
+  return _Transactions;                                                       // Return the counter               //
+} // of method getTransactions()                                              //                                  //
+uint32_t INA226_SimTransport::getBytes() {                                    // Bytes transferred since reset    //
+  return _Bytes;                                                              // Return the counter               //
+} // of method getBytes()                                                     //                                  //
+void INA226_SimTransport::resetCounters() {                                   // Reset transaction and byte count //
+  _Transactions = 0;                                                          // Reset both counters              //
+  _Bytes        = 0;                                                          //                                  //
+} // of method resetCounters()                                                //                                  //
+/*******************************************************************************************************************
+** Methods setDeferredCompletion and completeTransfer control when readRegisters() transfers. Once deferred,      **
+** readRegisters() stores the request and returns, completeTransfer() then makes the transfer and calls its       **
+** completion function. completeTransfer() returns false if no transfer was waiting, a transfer that is already   **
+** waiting is kept when deferring is switched off                                                                 **
+*******************************************************************************************************************/
+void INA226_SimTransport::setDeferredCompletion(const bool deferred) {        // Complete readRegisters() later   //
+  _Deferred = deferred;                                                       // Store the setting                //
+} // of method setDeferredCompletion()                                        //                                  //
+bool INA226_SimTransport::completeTransfer() {                                // Finish a deferred transfer       //
+  if (!_DeferredDone) return false;                                           // Return if nothing is waiting     //
+  inaTransferCallback done = _DeferredDone;                                   // Clear the request first, so that //
+  _DeferredDone = NULL;                                                       // done() can start another one     //
+  return INA226_Transport::readRegisters(_DeferredAddress,_DeferredRegister,  // Transfer now and report result   //
+                                         _DeferredData,_DeferredCount,        //                                  //
+                                         done,_DeferredContext);              //                                  //
+} // of method completeTransfer()                                             //                                  //
+/*******************************************************************************************************************
+** Methods begin and setClock have nothing to do as there is no bus                                               **
+*******************************************************************************************************************/
+void INA226_SimTransport::begin(const uint32_t i2cSpeed) {                    // Start the bus at the given speed //
+  (void)i2cSpeed;                                                             // No clock to set                  //
+} // of method begin()                                                        //                                  //
+void INA226_SimTransport::setClock(const uint32_t i2cSpeed) {                 // Change the bus clock speed       //
+  (void)i2cSpeed;                                                             // No clock to set                  //
+} // of method setClock()                                                     //                                  //
+/*******************************************************************************************************************
+** Method write simulates an I2C write to a device. The first byte sets the register pointer, with 2 more bytes   **
+** the register is written. Writing the configuration starts a new conversion (or resets the device) and clears   **
+** the conversion ready flag, the flags of the mask/enable register are read-only. Returns 2, the Wire code for a **
+** NACK on the address, if there is no device at the address                                                      **
+*******************************************************************************************************************/
+uint8_t INA226_SimTransport::write(const uint8_t address,                     // Write bytes, return 0 on success //
+                                   const uint8_t *data,                       // or the Wire error code           //
+                                   const uint8_t length,                      //                                  //
+                                   const bool sendStop) {                     //                                  //
+  (void)sendStop;                                                             // Bus states aren't simulated      //
+  _Transactions++;                                                            // Count the transaction            //
+  _Bytes += 1+length;                                                         // and the bytes including address  //
+  inaSimDevice *dev = find(address);                                          // Find the addressed device        //
+  if (!dev) return 2;                                                         // Address not acknowledged         //
+  if (length==0) return 0;                                                    // Just checking for the device     //
+  update(*dev);                                                               // Complete any conversion now due  //
+  dev->pointer = data[0];                                                     // First byte sets the pointer      //
+  if (length<3 || dev->pointer>=8) return 0;                                  // Done unless a register is written//
+  uint16_t value = (uint16_t)data[1]<<8|data[2];                              // Register value, msb first        //
+  switch (dev->pointer) {                                                     // Action depends on the register   //
+    case INA_CONFIGURATION_REGISTER:                                          // Configuration starts conversion  //
+      if (value&INA_RESET_DEVICE) {                                           // If the reset bit is set then     //
+        resetDevice(*dev);                                                    // return to the power-on state     //
+      } else {                                                                //                                  //
+        dev->reg[INA_CONFIGURATION_REGISTER] = value;                         // otherwise store the setting      //
+        dev->reg[INA_MASK_ENABLE_REGISTER]  &= ~INA_CONVERSION_READY_MASK;    // clear conversion ready and       //
+        startConversion(*dev);                                                // start a new conversion           //
+      } // of if-then-else reset                                              //                                  //
+      break;                                                                  //                                  //
+    case INA_CALIBRATION_REGISTER:                                            // Bit 15 of calibration is unused  //
+      dev->reg[INA_CALIBRATION_REGISTER] = value&0x7FFF;                      //                                  //
+      break;                                                                  //                                  //
+    case INA_MASK_ENABLE_REGISTER:                                            // Keep the read-only flags         //
+      dev->reg[INA_MASK_ENABLE_REGISTER] = (value&0xFC03)|                    //                                  //
+                                       (dev->reg[INA_MASK_ENABLE_REGISTER]&   //                                  //
+                                        INA_MASK_FLAGS);                      //                                  //
+      break;                                                                  //                                  //
+    case INA_SIM_LIMIT_REGISTER:                                              // Alert limit is read-write        //
+      dev->reg[INA_SIM_LIMIT_REGISTER] = value;                               //                                  //
+      break;                                                                  //                                  //
+  } // of switch register, the measurement registers are read-only            //                                  //
+  return 0;                                                                   // Return success                   //
+} // of method write()                                                        //                                  //
+/*******************************************************************************************************************
+** Method read simulates an I2C read of the register the pointer is set to, returning its msb and lsb. Reading    **
+** the mask/enable register clears the conversion ready flag and, in latch mode, the alert function flag. Returns **
+** the number of bytes sent, 0 if there is no device at the address                                               **
+*******************************************************************************************************************/
+uint8_t INA226_SimTransport::read(const uint8_t address, uint8_t *data,       // Read bytes, return the number    //
+                                  const uint8_t length,                       // of bytes received                //
+                                  const bool sendStop) {                      //                                  //
+  (void)sendStop;                                                             // Bus states aren't simulated      //
+  _Transactions++;                                                            // Count the transaction            //
+  _Bytes += 1+length;                                                         // and the bytes including address  //
+  inaSimDevice *dev = find(address);                                          // Find the addressed device        //
+  if (!dev) return 0;                                                         // Address not acknowledged         //
+  update(*dev);                                                               // Complete any conversion now due  //
+  uint16_t value = 0;                                                         // Contents of the register         //
+  if (dev->pointer<8) value = dev->reg[dev->pointer];                         // Registers 0 to 7                 //
+  else if (dev->pointer==INA_MANUFACTURER_ID_REGISTER)                        // or the identification registers  //
+    value = INA_SIM_MANUFACTURER_ID;                                          //                                  //
+  else if (dev->pointer==INA_SIM_DIE_ID_REGISTER)                             //                                  //
+    value = INA_SIM_DIE_ID;                                                   //                                  //
+  for(uint8_t i=0;i<length;i++) data[i] = i%2 ? value&0xFF : value>>8;        // Send msb and lsb                 //
+  if (dev->pointer==INA_MASK_ENABLE_REGISTER) {                               // Reading mask/enable clears flags //
+    dev->reg[INA_MASK_ENABLE_REGISTER] &= ~INA_CONVERSION_READY_MASK;         // Conversion ready always          //
+    if (dev->reg[INA_MASK_ENABLE_REGISTER]&INA_SIM_ALERT_LATCH)               // and the alert flag when latched  //
+      dev->reg[INA_MASK_ENABLE_REGISTER] &= ~INA_SIM_ALERT_FLAG;              //                                  //
+  } // of if-then mask/enable read                                            //                                  //
+  return length;                                                              // Return number of bytes sent      //
+} // of method read()                                                         //                                  //
+/*******************************************************************************************************************
+** Method readRegisters transfers immediately using the default version unless setDeferredCompletion() is set, in **
+** which case it stores the request for completeTransfer() and returns. Like a busy background transport it       **
+** returns false without storing anything while an earlier request is still waiting                               **
+*******************************************************************************************************************/
+bool INA226_SimTransport::readRegisters(const uint8_t address,                // Start reading consecutive 16 bit //
+                                        const uint8_t firstRegister,          // registers, deferred if enabled   //
+                                        uint8_t *data, const uint8_t count,   //                                  //
+                                        inaTransferCallback done,             //                                  //
+                                        void *context) {                      //                                  //
+  if (!_Deferred) return INA226_Transport::readRegisters(address,             // Transfer now unless deferred     //
+                                                         firstRegister,data,  //                                  //
+                                                         count,done,context); //                                  //
+  if (_DeferredDone) return false;                                            // Busy with an earlier request     //
+  _DeferredAddress  = address;                                                // Store the request                //
+  _DeferredRegister = firstRegister;                                          //                                  //
+  _DeferredData     = data;                                                   //                                  //
+  _DeferredCount    = count;                                                  //                                  //
+  _DeferredContext  = context;                                                //                                  //
+  _DeferredDone     = done;                                                   //                                  //
+  return true;                                                                // Transfer has been started        //
+} // of method readRegisters()                                                //                                  //
+/*******************************************************************************************************************
+** Method find returns the simulated device at an address, NULL if there is none                                  **
+*******************************************************************************************************************/
+inaSimDevice* INA226_SimTransport::find(const uint8_t address) {              // Return device at an address      //
+  for(uint8_t i=0;i<_DeviceCount;i++)                                         // Loop for each device             //
+    if (_Device[i].address==address) return &_Device[i];                      // Return it if address matches     //
+  return NULL;                                                                // Return NULL if not found         //
+} // of method find()                                                         //                                  //
+/*******************************************************************************************************************
+** Method resetDevice puts a device into its power-on state, which starts continuous conversions                  **
+*******************************************************************************************************************/
+void INA226_SimTransport::resetDevice(inaSimDevice &dev) {                    // Power-on reset of a device       //
+  memset(dev.reg,0,sizeof(dev.reg));                                          // All registers are 0              //
+  dev.reg[INA_CONFIGURATION_REGISTER] = INA_DEFAULT_CONFIGURATION;            // except the configuration         //
+  dev.pointer = INA_CONFIGURATION_REGISTER;                                   // Pointer starts at register 0     //
+  startConversion(dev);                                                       // Start converting                 //
+} // of method resetDevice()                                                  //                                  //
+/*******************************************************************************************************************
+** Method startConversion begins a new conversion unless the configuration selects power-down mode                **
+*******************************************************************************************************************/
+void INA226_SimTransport::startConversion(inaSimDevice &dev) {                // Begin a new conversion           //
+  dev.converting      = (dev.reg[INA_CONFIGURATION_REGISTER]&                 // Bus or shunt measurement enabled //
+                         INA_MODE_TRIGGERED_BOTH)!=0;                         //                                  //
+  dev.conversionStart = micros();                                             // Conversion begins now            //
+} // of method startConversion()                                              //                                  //
+/*******************************************************************************************************************
+** Method update completes a conversion once its conversion time has passed. In continuous mode the next one      **
+** starts immediately, so if several periods have passed only the results of the latest are kept                  **
+*******************************************************************************************************************/
+void INA226_SimTransport::update(inaSimDevice &dev) {                         // Complete conversions now due     //
+  if (!dev.converting) return;                                                // Nothing to do if idle            //
+  uint16_t configuration = dev.reg[INA_CONFIGURATION_REGISTER];               // Current settings                 //
+  uint32_t period  = INA226_Class::conversionMicros(configuration);           // Time for one measurement         //
+  uint32_t elapsed = micros()-dev.conversionStart;                            // Time since conversion began      //
+  if (elapsed<period) return;                                                 // Return if not finished yet       //
+  convert(dev);                                                               // Store the results                //
+  if (bitRead(configuration,2))                                               // In continuous mode keep going at //
+    dev.conversionStart += elapsed-elapsed%period;                            // the same pace                    //
+  else                                                                        //                                  //
+    dev.converting = false;                                                   // otherwise wait for next trigger  //
+} // of method update()                                                       //                                  //
+/*******************************************************************************************************************
+** Method convert stores the results of a finished conversion. The shunt and bus registers are only updated when  **
+** measured in the current mode, the current register is shunt*calibration/2048 and the power register is         **
+** current*bus/20000 as given in the datasheet. Then the conversion ready and alert function flags are set        **
+*******************************************************************************************************************/
+void INA226_SimTransport::convert(inaSimDevice &dev) {                        // Store results of a conversion    //
+  uint16_t configuration = dev.reg[INA_CONFIGURATION_REGISTER];               // Current settings                 //
+  if (bitRead(configuration,0)) {                                             // If shunt is measured             //
+    int32_t shunt = dev.shuntMicroVolts*10/INA_SHUNT_VOLTAGE_LSB;             // Convert to 2.5uV steps           //
+    dev.reg[INA_SHUNT_VOLTAGE_REGISTER] = (uint16_t)constrain(shunt,          // limited to register range        //
+                                                              INT16_MIN,      //                                  //
+                                                              INT16_MAX);     //                                  //
+  } // of if-then shunt measured                                              //                                  //
+  if (bitRead(configuration,1)) {                                             // If bus is measured               //
+    uint32_t bus = (uint32_t)dev.busMilliVolts*100/INA_BUS_VOLTAGE_LSB;       // Convert to 1.25mV steps          //
+    dev.reg[INA_BUS_VOLTAGE_REGISTER] = bus>0x7FFF ? 0x7FFF : bus;            // limited to 40.96V full scale     //
+  } // of if-then bus measured                                                //                                  //
+  int32_t current = (int32_t)(int16_t)dev.reg[INA_SHUNT_VOLTAGE_REGISTER]*    // Current from shunt voltage and   //
+                    dev.reg[INA_CALIBRATION_REGISTER]/2048;                   // calibration                      //
+  current = constrain(current,INT16_MIN,INT16_MAX);                           // limited to register range        //
+  dev.reg[INA_CURRENT_REGISTER] = (uint16_t)current;                          // Store current                    //
+  uint32_t power = (uint32_t)(current<0 ? -current : current)*                // Power from current and bus       //
+                   dev.reg[INA_BUS_VOLTAGE_REGISTER]/20000;                   // voltage, always positive         //
+  dev.reg[INA_POWER_REGISTER] = power>UINT16_MAX ? UINT16_MAX : power;        // Store power                      //
+  dev.reg[INA_MASK_ENABLE_REGISTER] |= INA_CONVERSION_READY_MASK;             // Flag the conversion as ready     //
+  if (alertCondition(dev))                                                    // Set alert flag if limit exceeded //
+    dev.reg[INA_MASK_ENABLE_REGISTER] |= INA_SIM_ALERT_FLAG;                  //                                  //
+  else if (!(dev.reg[INA_MASK_ENABLE_REGISTER]&INA_SIM_ALERT_LATCH))          // otherwise clear it unless it is  //
+    dev.reg[INA_MASK_ENABLE_REGISTER] &= ~INA_SIM_ALERT_FLAG;                 // latched                          //
+} // of method convert()                                                      //                                  //
+/*******************************************************************************************************************
+** Method alertCondition compares the latest results with the limit register according to the alert function      **
+** selected in the mask/enable register. Only one function is active, the most significant bit set wins           **
+*******************************************************************************************************************/
+bool INA226_SimTransport::alertCondition(const inaSimDevice &dev) {           // Check the alert function         //
+  uint16_t mask  = dev.reg[INA_MASK_ENABLE_REGISTER];                         // Alert function bits 11-15        //
+  uint16_t limit = dev.reg[INA_SIM_LIMIT_REGISTER];                           // Limit to compare with            //
+  if (mask&0x8000) return (int16_t)dev.reg[INA_SHUNT_VOLTAGE_REGISTER]>       // Shunt over-voltage               //
+                          (int16_t)limit;                                     //                                  //
+  if (mask&0x4000) return (int16_t)dev.reg[INA_SHUNT_VOLTAGE_REGISTER]<       // Shunt under-voltage              //
+                          (int16_t)limit;                                     //                                  //
+  if (mask&0x2000) return dev.reg[INA_BUS_VOLTAGE_REGISTER]>limit;            // Bus over-voltage                 //
+  if (mask&0x1000) return dev.reg[INA_BUS_VOLTAGE_REGISTER]<limit;            // Bus under-voltage                //
+  if (mask&0x0800) return dev.reg[INA_POWER_REGISTER]>limit;                  // Power over-limit                 //
+  return false;                                                               // No limit function selected       //
+} // of method alertCondition()                                               //                                  //
+/*******************************************************************************************************************
+** Methods read and write of INA226_SimStorage copy bytes from and to the simulated EEPROM. Addresses beyond the  **
+** end of the memory read as 0xFF, as erased EEPROM does, and writes to them are ignored                          **
+*******************************************************************************************************************/
+void INA226_SimStorage::read(const uint16_t address, void *data,              // Copy bytes out of storage        //
+                             const uint16_t length) {                         //                                  //
+  for(uint16_t i=0;i<length;i++) {                                            // Loop for each byte               //
+    uint32_t location = (uint32_t)address+i;                                  // Address of the byte              //
+    ((uint8_t*)data)[i] = location<INA_SIM_STORAGE_SIZE ? _Memory[location]   // Copy it or return erased value   //
+                                                        : 0xFF;               //                                  //
+  } // for-next each byte                                                     //                                  //
+} // of method read()                                                         //                                  //
+void INA226_SimStorage::write(const uint16_t address, const void *data,       // Copy bytes into storage          //
+                              const uint16_t length) {                        //                                  //
+  for(uint16_t i=0;i<length;i++) {                                            // Loop for each byte               //
+    uint32_t location = (uint32_t)address+i;                                  // Address of the byte              //
+    if (location<INA_SIM_STORAGE_SIZE) {                                      // Ignore bytes beyond the end      //
+      _Memory[location] = ((const uint8_t*)data)[i];                          // Store the byte                   //
+      _BytesWritten++;                                                        // and count it                     //
+    } // of if-then within memory                                             //                                  //
+  } // for-next each byte                                                     //                                  //
+} // of method write()                                                        //                                  //
+/*******************************************************************************************************************
+** Method length returns the size of the simulated EEPROM, INA_SIM_STORAGE_SIZE bytes                             **
+*******************************************************************************************************************/
+uint16_t INA226_SimStorage::length() {                                        // Size of the simulated EEPROM     //
+  return INA_SIM_STORAGE_SIZE;                                                // Return the size                  //
+} // of method length()                                                       //                                  //
+/*******************************************************************************************************************
+** Method getBytesWritten returns the number of bytes written to the simulated EEPROM                             **
+*******************************************************************************************************************/
+uint32_t INA226_SimStorage::getBytesWritten() {                               // Bytes written since start        //
+  return _BytesWritten;                                                       // Return the counter               //
+} // of method getBytesWritten()                                              //----------------------------------//
@@ -0,0 +1,122 @@
+/*******************************************************************************************************************
+** Class definition header for INA226_SimTransport and INA226_SimStorage, simulated hardware for the INA226       **
+** library. INA226_SimTransport implements INA226_Transport without any I2C bus, answering transfers for a number **
+** of simulated INA226 devices. Each device models the register set, the conversion time resulting from the       **
+** configuration register (see INA226_Class::conversionMicros()), the conversion ready flag and the alert         **
+** function, flag and pin including latching and polarity. The measured shunt and bus voltages are set using      **
+** setInputs(), the current and power registers are computed from them and the calibration register just as the   **
+** device does. Timing uses micros(), so conversions complete in real time.                                       **
+**                                                                                                                **
+** The transport counts the I2C transactions and bytes of all transfers, including the address byte sent at the   **
+** start of each transaction. Resetting the counters before a library call and reading them afterwards shows the  **
+** bus traffic the call causes, which makes the simulation useful for tracking bus efficiency on a board with no  **
+** INA226 connected                                                                                               **
+**                                                                                                                **
+** setDeferredCompletion() makes readRegisters() behave like a transport that transfers in the background: it     **
+** only stores the request and returns, the transfer is made and its completion function called by the next       **
+** completeTransfer(). This allows the pending state and callback of INA226_Class::startRawSample() to be tested  **
+**                                                                                                                **
+** INA226_SimStorage replaces the EEPROM used by saveDevices() and loadDevices() with an array in RAM.            **
+**                                                                                                                **
+** Usage: "INA226_SimTransport sim; sim.addDevice(0x40); INA226.setTransport(sim); INA226.begin(1,100000);"       **
+** The number of devices is set using INA_SIM_MAX_DEVICES and the storage size using INA_SIM_STORAGE_SIZE, both   **
+** can be overridden by build flags                                                                               **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_Sim_h                                                          // Guard code definition            //
+  #define INA226_Sim_h                                                        // Define the name inside guard code//
+  #ifndef INA_SIM_MAX_DEVICES                                                 // Can be overridden by build flags //
+    #define INA_SIM_MAX_DEVICES 4                                             // Number of simulated devices      //
+  #endif                                                                      //                                  //
+  #ifndef INA_SIM_STORAGE_SIZE                                                // Can be overridden by build flags //
+    #define INA_SIM_STORAGE_SIZE (1+INA_MAX_DEVICES*sizeof(inaDet))           // Space for saveDevices()          //
+  #endif                                                                      //                                  //
+  typedef struct {                                                            // Structure of simulated device    //
+    uint8_t  address;                                                         // I2C address of the device        //
+    uint8_t  pointer;                                                         // Register pointer                 //
+    uint16_t reg[8];                                                          // Registers 0 to 7                 //
+    int32_t  shuntMicroVolts;                                                 // Shunt voltage input              //
+    uint16_t busMilliVolts;                                                   // Bus voltage input                //
+    bool     converting;                                                      // Set while a conversion runs      //
+    uint32_t conversionStart;                                                 // micros() the conversion began    //
+  } inaSimDevice; // of structure                                             //                                  //
+  const uint16_t INA_SIM_MANUFACTURER_ID      = 0x5449;                       // "TI" in ASCII                    //
+  const uint16_t INA_SIM_DIE_ID               = 0x2260;                       // INA226 die ID, revision 0        //
+  const uint8_t  INA_SIM_DIE_ID_REGISTER      =   0xFF;                       // Register holding the die ID      //
+  const uint8_t  INA_SIM_LIMIT_REGISTER       =      7;                       // Alert limit register             //
+  const uint16_t INA_SIM_ALERT_FLAG           = 0x0010;                       // Bit 4, AFF                       //
+  const uint16_t INA_SIM_ALERT_ON_CONVERSION  = 0x0400;                       // Bit 10, CNVR                     //
+  const uint16_t INA_SIM_ALERT_POLARITY       = 0x0002;                       // Bit 1, APOL                      //
+  const uint16_t INA_SIM_ALERT_LATCH          = 0x0001;                       // Bit 0, LEN                       //
+  /*****************************************************************************************************************
+  ** Declare simulated transport class header                                                                     **
+  *****************************************************************************************************************/
+  class INA226_SimTransport : public INA226_Transport {                       // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_SimTransport();                                                  // Class constructor                //
+      uint8_t  addDevice(const uint8_t address);                              // Add a simulated device           //
+      void     setInputs(const uint8_t index, const int32_t shuntMicroVolts,  // Set the voltages a device        //
+                         const uint16_t busMilliVolts);                       // measures                         //
+      uint16_t getRegister(const uint8_t index, const uint8_t reg);           // Inspect a device register        //
+      uint8_t  getAlertPin(const uint8_t index);                              // Level of a device's alert pin    //
+      uint32_t getTransactions();                                             // I2C transactions since reset     //
+      uint32_t getBytes();                                                    // Bytes transferred since reset    //
+      void     resetCounters();                                               // Reset transaction and byte count //
+      void     setDeferredCompletion(const bool deferred);                    // Complete readRegisters() later   //
+      bool     completeTransfer();                                            // Finish a deferred transfer       //
+      void     begin(const uint32_t i2cSpeed);                                // Start the bus at the given speed //
+      void     setClock(const uint32_t i2cSpeed);                             // Change the bus clock speed       //
+      uint8_t  write(const uint8_t address, const uint8_t *data,              // Write bytes, return 0 on success //
+                     const uint8_t length, const bool sendStop);              // or the Wire error code           //
+      uint8_t  read(const uint8_t address, uint8_t *data,                     // Read bytes, return the number    //
+                    const uint8_t length, const bool sendStop);               // of bytes received                //
+      bool     readRegisters(const uint8_t address,                           // Start reading consecutive 16 bit //
+                             const uint8_t firstRegister,                     // registers, deferred if enabled   //
+                             uint8_t *data, const uint8_t count,              //                                  //
+                             inaTransferCallback done, void *context);        //                                  //
+    private:                                                                  // Private variables and methods    //
+      inaSimDevice* find(const uint8_t address);                              // Return device at an address      //
+      void     resetDevice(inaSimDevice &dev);                                // Power-on reset of a device       //
+      void     startConversion(inaSimDevice &dev);                            // Begin a new conversion           //
+      void     update(inaSimDevice &dev);                                     // Complete conversions now due     //
+      void     convert(inaSimDevice &dev);                                    // Store results of a conversion    //
+      bool     alertCondition(const inaSimDevice &dev);                       // Check the alert function         //
+      uint8_t  _DeviceCount  = 0;                                             // Number of simulated devices      //
+      uint32_t _Transactions = 0;                                             // I2C transactions since reset     //
+      uint32_t _Bytes        = 0;                                             // Bytes transferred since reset    //
+      bool     _Deferred     = false;                                         // Set to defer readRegisters()     //
+      inaTransferCallback _DeferredDone = NULL;                               // Set while a transfer is deferred //
+      void    *_DeferredContext  = NULL;                                      // Arguments of the deferred        //
+      uint8_t *_DeferredData     = NULL;                                      // readRegisters() call             //
+      uint8_t  _DeferredAddress  = 0;                                         //                                  //
+      uint8_t  _DeferredRegister = 0;                                         //                                  //
+      uint8_t  _DeferredCount    = 0;                                         //                                  //
+      inaSimDevice _Device[INA_SIM_MAX_DEVICES];                              // Simulated devices                //
+  }; // of INA226_SimTransport definition                                     //                                  //
+  /*****************************************************************************************************************
+  ** Declare simulated storage class header                                                                       **
+  *****************************************************************************************************************/
+  class INA226_SimStorage : public INA226_Storage {                           // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      void     read(const uint16_t address, void *data,                       // Copy bytes out of storage        //
+                    const uint16_t length);                                   //                                  //
+      void     write(const uint16_t address, const void *data,                // Copy bytes into storage          //
+                     const uint16_t length);                                  //                                  //
+      uint16_t length();                                                      // Size of the simulated EEPROM     //
+      uint32_t getBytesWritten();                                             // Bytes written since start        //
+    private:                                                                  // Private variables and methods    //
+      uint8_t  _Memory[INA_SIM_STORAGE_SIZE] = {};                            // Simulated EEPROM contents        //
+      uint32_t _BytesWritten = 0;                                             // Bytes written since start        //
+  }; // of INA226_SimStorage definition                                       //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,121 @@
+/*******************************************************************************************************************
+** INA226_Statistics class method definitions for INA226 Library.                                                 **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226_Statistics.h"                                                // Include the header definition    //
+INA226_Statistics::INA226_Statistics(INA226_Class &ina) : _INA(ina) {         // Class constructor                //
+  reset();                                                                    // Start with empty windows         //
+} // of class constructor                                                     //                                  //
+INA226_Statistics::~INA226_Statistics() {}                                    // Unused class destructor          //
+/*******************************************************************************************************************
+** Method add() adds the bus voltage and current registers of a sample to the window of its device. It only uses  **
+** integer arithmetic and no I2C transfers, so it can be called from within the startRawSample() callback         **
+*******************************************************************************************************************/
+void INA226_Statistics::add(const inaRawSample &sample) {                     // Add a sample to its device window//
+  inaMoments &m = _Moments[_INA.deviceIndex(sample.deviceNumber)];            // Window of the device             //
+  if (sample.bus<m.busMin) m.busMin = sample.bus;                             // Keep the extremes                //
+  if (sample.bus>m.busMax) m.busMax = sample.bus;                             //                                  //
+  if (sample.current<m.currentMin) m.currentMin = sample.current;             //                                  //
+  if (sample.current>m.currentMax) m.currentMax = sample.current;             //                                  //
+  m.busSum         += sample.bus;                                             // Add to the sums                  //
+  m.busSquares     += (uint32_t)sample.bus*sample.bus;                        //                                  //
+  m.currentSum     += sample.current;                                         //                                  //
+  m.currentSquares += (uint32_t)((int32_t)sample.current*sample.current);     //                                  //
+  m.samples++;                                                                // Count the sample                 //
+} // of method add()                                                          //                                  //
+/*******************************************************************************************************************
+** Method getSummary() converts the window of a device into millivolts and microamps, using the same LSB values   **
+** as INA226_Class, and by default starts a new window for that device. The means and root mean squares are       **
+** computed with 8 extra binary places so that they keep the precision gained by averaging. The current values    **
+** are corrected for the offset set with INA226_Class::setTrim(). It returns false and leaves "summary" unchanged **
+** if no samples have been added since the window started                                                         **
+*******************************************************************************************************************/
+bool INA226_Statistics::getSummary(inaSummary &summary,                       // Convert a device window and      //
+                                   const uint8_t deviceNumber,                // start a new one                  //
+                                   const bool restart) {                      //                                  //
+  uint8_t i = _INA.deviceIndex(deviceNumber);                                 // Table index of the device        //
+  noInterrupts();                                                             // Copy isn't atomic, and add() may //
+  inaMoments m = _Moments[i];                                                 // run in an interrupt              //
+  if (restart) clear(_Moments[i]);                                            // Start a new window if wanted     //
+  interrupts();                                                               //                                  //
+  if (m.samples==0) return false;                                             // Nothing to convert               //
+  int64_t  lsb    = _INA.getCurrentLSB(i);                                    // Current LSB of the device        //
+  int64_t  offset = _INA.getCurrentOffset(i);                                 // and setTrim() offset to remove   //
+  m.currentSquares += offset*(offset*m.samples-2*m.currentSum);               // Squares of (x-offset) sum to the //
+  m.currentSum     -= offset*m.samples;                                       // squares-2*offset*sum+n*offset^2  //
+  uint64_t busMean     = (m.busSum<<8)/m.samples;                             // Means and root mean squares in   //
+  int64_t  currentMean = m.currentSum*256/m.samples;                          // register units * 256             //
+  uint32_t busRMS      = squareRoot(scaledMean(m.busSquares,m.samples));      //                                  //
+  uint32_t currentRMS  = squareRoot(scaledMean(m.currentSquares,m.samples));  //                                  //
+  summary.samples           = m.samples;                                      // Convert to millivolts            //
+  summary.minBusMilliVolts  = (uint32_t)m.busMin*INA_BUS_VOLTAGE_LSB/100;     //                                  //
+  summary.maxBusMilliVolts  = (uint32_t)m.busMax*INA_BUS_VOLTAGE_LSB/100;     //                                  //
+  summary.meanBusMilliVolts = busMean*INA_BUS_VOLTAGE_LSB/25600;              //                                  //
+  summary.rmsBusMilliVolts  = (uint64_t)busRMS*INA_BUS_VOLTAGE_LSB/25600;     //                                  //
+  summary.minBusMicroAmps   = (m.currentMin-offset)*lsb/INA_CURRENT_DIVISOR;  // and microamps                    //
+  summary.maxBusMicroAmps   = (m.currentMax-offset)*lsb/INA_CURRENT_DIVISOR;  //                                  //
+  summary.meanBusMicroAmps  = currentMean*lsb/INA_CURRENT_DIVISOR/256;        //                                  //
+  summary.rmsBusMicroAmps   = currentRMS*lsb/INA_CURRENT_DIVISOR/256;         //                                  //
+  return true;                                                                // Return summary converted         //
+} // of method getSummary()                                                   //                                  //
+/*******************************************************************************************************************
+** Method reset() starts a new window for one device or, by default, for all of them                              **
+*******************************************************************************************************************/
+void INA226_Statistics::reset(const uint8_t deviceNumber) {                   // Start new windows                //
+  for(uint8_t i=0;i<INA_MAX_DEVICES;i++) {                                    // Loop for each table entry        //
+    if(deviceNumber==UINT8_MAX || _INA.deviceIndex(deviceNumber)==i) {        // If this device needs resetting   //
+      noInterrupts();                                                         // Not atomic, see getSummary()     //
+      clear(_Moments[i]);                                                     // Empty the window                 //
+      interrupts();                                                           //                                  //
+    } // of if this device needs to be reset                                  //                                  //
+  } // for-next each device                                                   //                                  //
+} // of method reset()                                                        //                                  //
+/*******************************************************************************************************************
+** Method clear() empties a window, setting the extremes so that they are replaced by the first sample            **
+*******************************************************************************************************************/
+void INA226_Statistics::clear(inaMoments &moments) {                          // Empty a window                   //
+  memset(&moments,0,sizeof(inaMoments));                                      // Clear the sums                   //
+  moments.busMin     = UINT16_MAX;                                            // and set the extremes             //
+  moments.currentMin = INT16_MAX;                                             //                                  //
+  moments.currentMax = INT16_MIN;                                             //                                  //
+} // of method clear()                                                        //                                  //
+/*******************************************************************************************************************
+** Method scaledMean() returns sum*65536/samples, rounded down. Shifting the sum first would overflow once it     **
+** reaches 2^48, e.g. after 65536 full scale bus voltage squares, and dividing first would lose the fraction of   **
+** the mean square. So the quotient and the remainder are scaled separately, the remainder is less than the       **
+** number of samples and can always be shifted                                                                    **
+*******************************************************************************************************************/
+uint64_t INA226_Statistics::scaledMean(const uint64_t sum,                    // Mean * 65536 without overflowing //
+                                       const uint32_t samples) {              //                                  //
+  return ((sum/samples)<<16)+((sum%samples)<<16)/samples;                     // Quotient and remainder scaled    //
+} // of method scaledMean()                                                   //                                  //
+/*******************************************************************************************************************
+** Method squareRoot() returns the integer square root of a 64 bit value, rounded down, computing one bit of the  **
+** result per iteration without any division                                                                      **
+*******************************************************************************************************************/
+uint32_t INA226_Statistics::squareRoot(const uint64_t value) {                // Integer square root              //
+  uint64_t remainder = value;                                                 // Part of the value still to match //
+  uint64_t root      = 0;                                                     // Result so far, shifted           //
+  uint64_t place     = (uint64_t)1<<62;                                       // Largest power of 4 to try        //
+  while (place>remainder) place >>= 2;                                        // Skip the leading zero bits       //
+  while (place) {                                                             // Loop for each bit of the result  //
+    if (remainder>=root+place) {                                              // If this bit is set then subtract //
+      remainder -= root+place;                                                // and add it to the root           //
+      root       = (root>>1)+place;                                           //                                  //
+    } else {                                                                  //                                  //
+      root >>= 1;                                                             // otherwise just shift             //
+    } // of if-then-else bit set                                              //                                  //
+    place >>= 2;                                                              // Next bit                         //
+  } // of while bits left                                                     //                                  //
+  return root;                                                                // Return the square root           //
+} // of method squareRoot()                                                   //----------------------------------//
@@ -0,0 +1,71 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_Statistics class, which keeps the minimum, maximum, mean and root mean  **
+** square of the bus voltage and current of each INA226 device over a window of samples. The samples are added as **
+** raw register values, so each one only costs a few integer additions and one multiplication per value, and the  **
+** full precision conversion into millivolts and microamps is done once per window when the results are read.     **
+** Samples can be added directly with add(), from the callback of INA226_Class::startRawSample(), or by attaching **
+** the statistics to an INA226_Sampler which then adds every reading it takes.                                    **
+**                                                                                                                **
+** getSummary() copies and converts the results of a device and starts a new window, so a program can aggregate   **
+** at the full sample rate and only report the summaries. The sums and sums of squares are 64 bit values, a       **
+** window can hold more than 4 billion samples without overflowing.                                               **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // INA226 class definitions         //
+#ifndef INA226_Statistics_h                                                   // Guard code definition            //
+  #define INA226_Statistics_h                                                 // Define the name inside guard code//
+  /*****************************************************************************************************************
+  ** Declare structures used in the class                                                                         **
+  *****************************************************************************************************************/
+  typedef struct {                                                            // Statistics of a window of samples//
+    uint32_t samples;                                                         // Number of samples in the window  //
+    uint16_t minBusMilliVolts;                                                // Bus voltage in mV                //
+    uint16_t maxBusMilliVolts;                                                //                                  //
+    uint16_t meanBusMilliVolts;                                               //                                  //
+    uint16_t rmsBusMilliVolts;                                                //                                  //
+    int32_t  minBusMicroAmps;                                                 // Current in uA                    //
+    int32_t  maxBusMicroAmps;                                                 //                                  //
+    int32_t  meanBusMicroAmps;                                                //                                  //
+    int32_t  rmsBusMicroAmps;                                                 //                                  //
+  } inaSummary; // of structure                                               //                                  //
+  typedef struct {                                                            // Raw sums of a window of samples  //
+    uint32_t samples;                                                         // Number of samples added          //
+    uint16_t busMin;                                                          // Bus voltage register extremes    //
+    uint16_t busMax;                                                          //                                  //
+    int16_t  currentMin;                                                      // Current register extremes        //
+    int16_t  currentMax;                                                      //                                  //
+    uint64_t busSum;                                                          // Sum of bus voltage registers     //
+    uint64_t busSquares;                                                      // and of their squares             //
+    int64_t  currentSum;                                                      // Sum of current registers         //
+    uint64_t currentSquares;                                                  // and of their squares             //
+  } inaMoments; // of structure                                               //                                  //
+  /*****************************************************************************************************************
+  ** Declare class header                                                                                         **
+  *****************************************************************************************************************/
+  class INA226_Statistics {                                                   // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_Statistics(INA226_Class &ina);                                   // Class constructor                //
+      ~INA226_Statistics();                                                   // Class destructor                 //
+      void     add(const inaRawSample &sample);                               // Add a sample to its device window//
+      bool     getSummary(inaSummary &summary,                                // Convert a device window and      //
+                          const uint8_t deviceNumber=0,                       // start a new one                  //
+                          const bool restart=true);                           //                                  //
+      void     reset(const uint8_t deviceNumber=UINT8_MAX);                   // Start new windows                //
+    private:                                                                  // Private variables and methods    //
+      void     clear(inaMoments &moments);                                    // Empty a window                   //
+      static uint64_t scaledMean(const uint64_t sum, const uint32_t samples); // Mean * 65536 without overflowing //
+      static uint32_t squareRoot(const uint64_t value);                       // Integer square root              //
+      INA226_Class &_INA;                                                     // Devices being measured           //
+      inaMoments _Moments[INA_MAX_DEVICES];                                   // Sums of the current windows      //
+  }; // of INA226_Statistics definition                                       //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,201 @@
+/*******************************************************************************************************************
+** INA226_Transport class method definitions for INA226 Library.                                                  **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "INA226.h"                                                           // Include the header definitions   //
+#include <EEPROM.h>                                                           // Include the EEPROM library       //
+/*******************************************************************************************************************
+** Method readRegisters reads "count" consecutive registers starting at "firstRegister", each as 2 bytes with the **
+** most significant byte first. The INA226 doesn't auto-increment its register pointer, so each register gets a   **
+** pointer write followed by a repeated start and the read. This default version completes the transfer before    **
+** returning and calls done() with the result. Transports that transfer in the background start the transfer,     **
+** return and call done() from their completion interrupt; they return false if a transfer is still in progress   **
+*******************************************************************************************************************/
+bool INA226_Transport::readRegisters(const uint8_t address,                   // Start reading consecutive 16 bit //
+                                     const uint8_t firstRegister,             // registers, big-endian into data, //
+                                     uint8_t *data, const uint8_t count,      // calling done() when finished     //
+                                     inaTransferCallback done,                //                                  //
+                                     void *context) {                         //                                  //
+  uint8_t status = INA_STATUS_OK;                                             // Result of the transfer           //
+  for(uint8_t i=0;i<count && status==INA_STATUS_OK;i++) {                     // Loop for each register to read   //
+    uint8_t reg = firstRegister+i;                                            // Register to read                 //
+    bool lastRegister = (i==count-1);                                         // Only send a stop after the last  //
+    status = write(address,&reg,1,false);                                     // Pointer write, repeated start    //
+    if (status==INA_STATUS_OK && read(address,&data[i*2],2,lastRegister)!=2)  // Read the register                //
+      status = INA_STATUS_READ_ERROR;                                         // Flag error if the read fails     //
+  } // for-next each register                                                 //                                  //
+  done(context,status);                                                       // Report the result                //
+  return true;                                                                // Transfer was started             //
+} // of method readRegisters()                                                //                                  //
+INA226_WireTransport::INA226_WireTransport(TwoWire &wire) : _Wire(&wire) {}   // Class constructor                //
+/*******************************************************************************************************************
+** Method setWire changes the I2C bus used by the transport                                                       **
+*******************************************************************************************************************/
+void INA226_WireTransport::setWire(TwoWire &wire) {                           // Change the I2C bus used          //
+  _Wire = &wire;                                                              // Store the bus                    //
+} // of method setWire()                                                      //                                  //
+/*******************************************************************************************************************
+** Methods begin and setClock start the I2C bus and set its clock speed                                           **
+*******************************************************************************************************************/
+void INA226_WireTransport::begin(const uint32_t i2cSpeed) {                   // Start the bus at the given speed //
+  _Wire->begin();                                                             // Start the I2C wire subsystem     //
+  _Wire->setClock(i2cSpeed);                                                  // Set the I2C clock speed          //
+} // of method begin()                                                        //                                  //
+void INA226_WireTransport::setClock(const uint32_t i2cSpeed) {                // Change the bus clock speed       //
+  _Wire->setClock(i2cSpeed);                                                  // Set the I2C clock speed          //
+} // of method setClock()                                                     //                                  //
+/*******************************************************************************************************************
+** Method write sends "length" bytes to the device, a length of 0 just checks whether the device answers. Without **
+** "sendStop" the bus is kept with a repeated start for the read which follows                                    **
+*******************************************************************************************************************/
+uint8_t INA226_WireTransport::write(const uint8_t address,                    // Write bytes, return 0 on success //
+                                    const uint8_t *data,                      // or the Wire error code           //
+                                    const uint8_t length,                     //                                  //
+                                    const bool sendStop) {                    //                                  //
+  _Wire->beginTransmission(address);                                          // Address the I2C device           //
+  if (length) _Wire->write(data,length);                                      // Send the data                    //
+  return _Wire->endTransmission(sendStop);                                    // Return the result                //
+} // of method write()                                                        //                                  //
+/*******************************************************************************************************************
+** Method read requests "length" bytes from the device and stores them in "data". Returns the number of bytes     **
+** the device sent, bytes not received are stored as the value returned by Wire.read()                            **
+*******************************************************************************************************************/
+uint8_t INA226_WireTransport::read(const uint8_t address, uint8_t *data,      // Read bytes, return the number    //
+                                   const uint8_t length,                      // of bytes received                //
+                                   const bool sendStop) {                     //                                  //
+  uint8_t received = _Wire->requestFrom(address,length,(uint8_t)sendStop);    // Request the data                 //
+  for(uint8_t i=0;i<length;i++) data[i] = _Wire->read();                      // Copy it out of the Wire buffer   //
+  return received;                                                            // Return number of bytes received  //
+} // of method read()                                                         //                                  //
+INA226_CountingTransport::INA226_CountingTransport(INA226_Transport &target) :// Class constructor                //
+  _Transport(target) {}                                                       //                                  //
+/*******************************************************************************************************************
+** Methods getTransactions, getBytes and resetCounters report and reset the bus traffic counters of the counting  **
+** transport. Every transaction counts one address byte plus the bytes written or received                        **
+*******************************************************************************************************************/
+uint32_t INA226_CountingTransport::getTransactions() {                        // I2C transactions since reset     //
+  return _Transactions;                                                       // Return the counter               //
+} // of method getTransactions()                                              //                                  //
+uint32_t INA226_CountingTransport::getBytes() {                               // Bytes transferred since reset    //
+  return _Bytes;                                                              // Return the counter               //
+} // of method getBytes()                                                     //                                  //
+void INA226_CountingTransport::resetCounters() {                              // Reset transaction and byte count //
+  _Transactions = 0;                                                          // Reset both counters              //
+  _Bytes        = 0;                                                          //                                  //
+} // of method resetCounters()                                                //                                  //
+/*******************************************************************************************************************
+** Methods begin, setClock, write and read pass the call on to the transport given to the constructor, counting   **
+** the transactions and bytes of write and read                                                                   **
+*******************************************************************************************************************/
+void INA226_CountingTransport::begin(const uint32_t i2cSpeed) {               // Start the bus at the given speed //
+  _Transport.begin(i2cSpeed);                                                 // Pass on the call                 //
+} // of method begin()                                                        //                                  //
+void INA226_CountingTransport::setClock(const uint32_t i2cSpeed) {            // Change the bus clock speed       //
+  _Transport.setClock(i2cSpeed);                                              // Pass on the call                 //
+} // of method setClock()                                                     //                                  //
+uint8_t INA226_CountingTransport::write(const uint8_t address,                // Count and pass on a write        //
+                                        const uint8_t *data,                  //                                  //
+                                        const uint8_t length,                 //                                  //
+                                        const bool sendStop) {                //                                  //
+  _Transactions++;                                                            // One transaction with the address //
+  _Bytes += 1+length;                                                         // and the data bytes               //
+  return _Transport.write(address,data,length,sendStop);                      // Pass on the call                 //
+} // of method write()                                                        //                                  //
+uint8_t INA226_CountingTransport::read(const uint8_t address, uint8_t *data,  // Count and pass on a read         //
+                                       const uint8_t length,                  //                                  //
+                                       const bool sendStop) {                 //                                  //
+  uint8_t received = _Transport.read(address,data,length,sendStop);           // Pass on the call                 //
+  _Transactions++;                                                            // One transaction with the address //
+  _Bytes += 1+received;                                                       // and the bytes received           //
+  return received;                                                            // Return number of bytes received  //
+} // of method read()                                                         //                                  //
+/*******************************************************************************************************************
+** Method readRegisters passes the call on as well, so that a transport which transfers in the background keeps   **
+** doing so. Each register is counted as a pointer write of 2 bytes and a read of 3 bytes, the traffic of the     **
+** default readRegisters(), once the transfer has been started                                                    **
+*******************************************************************************************************************/
+bool INA226_CountingTransport::readRegisters(const uint8_t address,           // Count and pass on a register read//
+                                             const uint8_t firstRegister,     //                                  //
+                                             uint8_t *data,                   //                                  //
+                                             const uint8_t count,             //                                  //
+                                             inaTransferCallback done,        //                                  //
+                                             void *context) {                 //                                  //
+  bool started = _Transport.readRegisters(address,firstRegister,data,count,   // Pass on the call                 //
+                                          done,context);                      //                                  //
+  if (started) {                                                              // Count if the transfer was started//
+    _Transactions += 2*count;                                                 // Pointer write and read per       //
+    _Bytes        += 5*count;                                                 // register, with address bytes     //
+  } // of if-then transfer started                                            //                                  //
+  return started;                                                             // Return true if started           //
+} // of method readRegisters()                                                //                                  //
+/*******************************************************************************************************************
+** Method read copies "length" bytes starting at EEPROM address "address" into "data"                             **
+*******************************************************************************************************************/
+void INA226_EEPROMStorage::read(const uint16_t address, void *data,           // Copy bytes out of EEPROM         //
+                                const uint16_t length) {                      //                                  //
+  #ifdef INA_EEPROM_EMULATED                                                  // Emulated EEPROM has to be started//
+    begin();                                                                  //                                  //
+  #endif                                                                      //                                  //
+  for(uint16_t i=0;i<length;i++)                                              // Loop for each byte               //
+    ((uint8_t*)data)[i] = EEPROM.read(address+i);                             // Read it from EEPROM              //
+} // of method read()                                                         //                                  //
+/*******************************************************************************************************************
+** Method write copies "length" bytes from "data" to EEPROM starting at "address". Only bytes which have changed  **
+** are written, to minimize the wear on the EEPROM cells. Emulated EEPROM is only changed in RAM until commit()   **
+** is called                                                                                                      **
+*******************************************************************************************************************/
+void INA226_EEPROMStorage::write(const uint16_t address, const void *data,    // Copy changed bytes into EEPROM   //
+                                 const uint16_t length) {                     //                                  //
+  #ifdef INA_EEPROM_EMULATED                                                  // Emulated EEPROM has to be started//
+    begin();                                                                  //                                  //
+  #endif                                                                      //                                  //
+  for(uint16_t i=0;i<length;i++) {                                            // Loop for each byte               //
+    uint8_t value = ((const uint8_t*)data)[i];                                // Byte to store                    //
+    if (EEPROM.read(address+i)!=value) {                                      // Only write if it has changed     //
+      EEPROM.write(address+i,value);                                          //                                  //
+      #ifdef INA_EEPROM_EMULATED                                              // Remember to commit the RAM copy  //
+        _Changed = true;                                                      //                                  //
+      #endif                                                                  //                                  //
+    } // of if-then byte changed                                              //                                  //
+  } // for-next each byte                                                     //                                  //
+} // of method write()                                                        //                                  //
+/*******************************************************************************************************************
+** Method length returns the size of the EEPROM, for emulated EEPROM the INA_EEPROM_SIZE bytes started by begin() **
+*******************************************************************************************************************/
+uint16_t INA226_EEPROMStorage::length() {                                     // Size of the EEPROM in bytes      //
+  #ifdef INA_EEPROM_EMULATED                                                  // Emulated EEPROM has to be started//
+    begin();                                                                  //                                  //
+  #endif                                                                      //                                  //
+  return EEPROM.length();                                                     // Return the size                  //
+} // of method length()                                                       //                                  //
+/*******************************************************************************************************************
+** Method commit copies the RAM copy of emulated EEPROM to flash if write() changed it since the last commit,     **
+** real EEPROM has been written already so there is nothing to do                                                 **
+*******************************************************************************************************************/
+void INA226_EEPROMStorage::commit() {                                         // Commit emulated EEPROM to flash  //
+  #ifdef INA_EEPROM_EMULATED                                                  // Only emulated EEPROM is buffered //
+    if (_Changed) EEPROM.commit();                                            // Erase and write the flash sector //
+    _Changed = false;                                                         //                                  //
+  #endif                                                                      //                                  //
+} // of method commit()                                                       //                                  //
+/*******************************************************************************************************************
+** Method begin starts the EEPROM emulation of the ESP32, ESP8266 and RP2040 cores, which keeps a copy of the     **
+** flash sector in RAM, the first time the storage is used                                                        **
+*******************************************************************************************************************/
+#ifdef INA_EEPROM_EMULATED                                                    // Only needed for emulated EEPROM  //
+  void INA226_EEPROMStorage::begin() {                                        // Start the EEPROM emulation once  //
+    if (_Started) return;                                                     // Nothing to do if already started //
+    EEPROM.begin(INA_EEPROM_SIZE);                                            // Allocate and read the RAM copy   //
+    _Started = true;                                                          //                                  //
+  } // of method begin()                                                      //                                  //
+#endif                                                                        //----------------------------------//
@@ -0,0 +1,135 @@
+/*******************************************************************************************************************
+** Class definition header for the INA226_Transport classes, the layer between INA226_Class and the I2C bus. Each **
+** bus used by INA226_Class has a transport which performs the actual transfers. The default is an instance of    **
+** INA226_WireTransport, which uses the blocking calls of the Arduino "Wire" library exactly as before. Other     **
+** transports can be attached to a bus with INA226_Class::setTransport(), for example one which uses the DMA or   **
+** interrupt-driven I2C driver of a SAMD, STM32 or ESP32 processor.                                               **
+**                                                                                                                **
+** Derived classes have to implement begin(), setClock(), write() and read(). Transports able to transfer in the  **
+** background also override readRegisters(), which starts reading a group of registers and returns immediately,   **
+** calling the completion function once all the data has arrived. The default readRegisters() performs the        **
+** transfer with write() and read() and calls the completion function before returning, so it works everywhere.   **
+**                                                                                                                **
+** INA226_CountingTransport is placed between INA226_Class and another transport and counts the I2C transactions  **
+** and bytes of all transfers, including the address byte of each transaction, for measuring the bus traffic of   **
+** library calls.                                                                                                 **
+**                                                                                                                **
+** In the same way INA226_Storage is the layer between saveDevices()/loadDevices() and the non-volatile memory,   **
+** by default INA226_EEPROMStorage which uses the Arduino "EEPROM" library. Together they allow INA226_Class to   **
+** run against simulated hardware, see INA226_Sim.h. On the ESP32, ESP8266 and RP2040 the EEPROM is emulated in   **
+** flash, the storage then calls EEPROM.begin() with INA_EEPROM_SIZE bytes before its first access, and commit()  **
+** calls EEPROM.commit() if anything was written since the last commit, so that saveDevices() erases the flash    **
+** sector at most once. INA_EEPROM_SIZE covers saveDevices() at address 0 and can be overridden by build flags    **
+** when another address is used or the sketch stores data of its own                                              **
+**                                                                                                                **
+** See the INA226.h header file comments for version information. Detailed documentation for the library can be   **
+** found on the GitHub Wiki pages at https://github.com/SV-Zanshin/INA226/wiki                                    **
+**                                                                                                                **
+** This program is free software: you can redistribute it and/or modify it under the terms of the GNU General     **
+** Public License as published by the Free Software Foundation, either version 3 of the License, or (at your      **
+** option) any later version. This program is distributed in the hope that it will be useful, but WITHOUT ANY     **
+** WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   **
+** GNU General Public License for more details. You should have received a copy of the GNU General Public License **
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.                                          **
+**                                                                                                                **
+*******************************************************************************************************************/
+#include "Arduino.h"                                                          // Arduino data type definitions    //
+#include <Wire.h>                                                             // I2C Library definition           //
+#ifndef INA226_Transport_h                                                    // Guard code definition            //
+  #define INA226_Transport_h                                                  // Define the name inside guard code//
+  typedef void (*inaTransferCallback)(void *context, const uint8_t status);   // Called when a transfer completes //
+  #if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040)      // EEPROM emulated in flash needs   //
+    #define INA_EEPROM_EMULATED                                               // begin() and commit() calls       //
+    #ifndef INA_EEPROM_SIZE                                                   // Can be overridden by build flags //
+      #define INA_EEPROM_SIZE (1+INA_MAX_DEVICES*sizeof(inaDet))              // Space for saveDevices()          //
+    #endif                                                                    //                                  //
+  #endif                                                                      //                                  //
+  /*****************************************************************************************************************
+  ** Declare the transport interface                                                                              **
+  *****************************************************************************************************************/
+  class INA226_Transport {                                                    // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      virtual ~INA226_Transport() {}                                          // Class destructor                 //
+      virtual void    begin(const uint32_t i2cSpeed) = 0;                     // Start the bus at the given speed //
+      virtual void    setClock(const uint32_t i2cSpeed) = 0;                  // Change the bus clock speed       //
+      virtual uint8_t write(const uint8_t address, const uint8_t *data,       // Write bytes, return 0 on success //
+                            const uint8_t length, const bool sendStop) = 0;   // or the Wire error code           //
+      virtual uint8_t read(const uint8_t address, uint8_t *data,              // Read bytes, return the number    //
+                           const uint8_t length, const bool sendStop) = 0;    // of bytes received                //
+      virtual bool    readRegisters(const uint8_t address,                    // Start reading consecutive 16 bit //
+                                    const uint8_t firstRegister,              // registers, big-endian into data, //
+                                    uint8_t *data, const uint8_t count,       // calling done() when finished     //
+                                    inaTransferCallback done, void *context); //                                  //
+  }; // of INA226_Transport definition                                        //                                  //
+  /*****************************************************************************************************************
+  ** Declare the default transport using the Arduino "Wire" library                                               **
+  *****************************************************************************************************************/
+  class INA226_WireTransport : public INA226_Transport {                      // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_WireTransport(TwoWire &wire=Wire);                               // Class constructor                //
+      void    setWire(TwoWire &wire);                                         // Change the I2C bus used          //
+      void    begin(const uint32_t i2cSpeed);                                 // Start the bus at the given speed //
+      void    setClock(const uint32_t i2cSpeed);                              // Change the bus clock speed       //
+      uint8_t write(const uint8_t address, const uint8_t *data,               // Write bytes, return 0 on success //
+                    const uint8_t length, const bool sendStop);               // or the Wire error code           //
+      uint8_t read(const uint8_t address, uint8_t *data,                      // Read bytes, return the number    //
+                   const uint8_t length, const bool sendStop);                // of bytes received                //
+    private:                                                                  // Private variables and methods    //
+      TwoWire *_Wire;                                                         // I2C bus used                     //
+  }; // of INA226_WireTransport definition                                    //                                  //
+  /*****************************************************************************************************************
+  ** Declare the transport counting the bus traffic of another transport                                          **
+  *****************************************************************************************************************/
+  class INA226_CountingTransport : public INA226_Transport {                  // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      INA226_CountingTransport(INA226_Transport &target);                     // Class constructor                //
+      uint32_t getTransactions();                                             // I2C transactions since reset     //
+      uint32_t getBytes();                                                    // Bytes transferred since reset    //
+      void     resetCounters();                                               // Reset transaction and byte count //
+      void     begin(const uint32_t i2cSpeed);                                // Start the bus at the given speed //
+      void     setClock(const uint32_t i2cSpeed);                             // Change the bus clock speed       //
+      uint8_t  write(const uint8_t address, const uint8_t *data,              // Count and pass on a write        //
+                     const uint8_t length, const bool sendStop);              //                                  //
+      uint8_t  read(const uint8_t address, uint8_t *data,                     // Count and pass on a read         //
+                    const uint8_t length, const bool sendStop);               //                                  //
+      bool     readRegisters(const uint8_t address,                           // Count and pass on a register read//
+                             const uint8_t firstRegister,                     //                                  //
+                             uint8_t *data, const uint8_t count,              //                                  //
+                             inaTransferCallback done, void *context);        //                                  //
+    private:                                                                  // Private variables and methods    //
+      INA226_Transport &_Transport;                                           // Transport doing the transfers    //
+      uint32_t _Transactions = 0;                                             // I2C transactions since reset     //
+      uint32_t _Bytes        = 0;                                             // Bytes transferred since reset    //
+  }; // of INA226_CountingTransport definition                                //                                  //
+  /*****************************************************************************************************************
+  ** Declare the storage interface used by saveDevices() and loadDevices()                                        **
+  *****************************************************************************************************************/
+  class INA226_Storage {                                                      // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      virtual ~INA226_Storage() {}                                            // Class destructor                 //
+      virtual void read(const uint16_t address, void *data,                   // Copy bytes out of storage        //
+                        const uint16_t length) = 0;                           //                                  //
+      virtual void write(const uint16_t address, const void *data,            // Copy bytes into storage          //
+                         const uint16_t length) = 0;                          //                                  //
+      virtual uint16_t length() = 0;                                          // Size of the storage in bytes     //
+      virtual void commit() {}                                                // Make the writes permanent        //
+  }; // of INA226_Storage definition                                          //                                  //
+  /*****************************************************************************************************************
+  ** Declare the default storage using the Arduino "EEPROM" library                                               **
+  *****************************************************************************************************************/
+  class INA226_EEPROMStorage : public INA226_Storage {                        // Class definition                 //
+    public:                                                                   // Publicly visible methods         //
+      void read(const uint16_t address, void *data,                           // Copy bytes out of EEPROM         //
+                const uint16_t length);                                       //                                  //
+      void write(const uint16_t address, const void *data,                    // Copy changed bytes into EEPROM   //
+                 const uint16_t length);                                      //                                  //
+      uint16_t length();                                                      // Size of the EEPROM in bytes      //
+      void commit();                                                          // Commit emulated EEPROM to flash  //
+  #ifdef INA_EEPROM_EMULATED                                                  // Only needed for emulated EEPROM  //
+    private:                                                                  // Private variables and methods    //
+      void begin();                                                           // Start the EEPROM emulation once  //
+      bool _Started = false;                                                  // Set after EEPROM.begin()         //
+      bool _Changed = false;                                                  // Set by write() until commit()    //
+  #endif                                                                      //                                  //
+  }; // of INA226_EEPROMStorage definition                                    //                                  //
+#endif                                                                        //----------------------------------//